@@ -9,6 +9,8 @@
 #include <bit>
 #include <cassert>
 #include "move/move.h"
+#include "engine/score.h"
+#include "engine/nnue.h"
 #include "chess_types.h"
 
 /**
@@ -95,6 +97,53 @@ public:
         return pieceBitboards[toIndex(opposingColour)][toIndex(piece)];
     } 
 
+    /**
+     * @brief Gets the total material value of a colour's pieces (including the king)
+     * @param colour Colour of player
+     * @return Material value of the player's pieces
+     * @note This value is updated incrementally as pieces are added and removed
+     */
+    inline int16_t getMaterial(Colour colour) const {
+        return materialScores[toIndex(colour)];
+    }
+
+    /**
+     * @brief Gets the sum of the piece square table values of a colour's pieces
+     * @param colour Colour of player
+     * @return Packed early game and end game piece square table score of the player's pieces
+     * @note This value is updated incrementally as pieces are added and removed
+     */
+    inline Score getPieceSquareScore(Colour colour) const {
+        return pieceSquareScores[toIndex(colour)];
+    }
+
+    /**
+     * @brief Gets the NNUE accumulator of the current position
+     * @return Accumulator of the current position
+     * @note The accumulator is rebuilt from scratch if it was not built with the currently loaded network,
+     * after which it is updated incrementally as pieces are added and removed
+     * @warning A network must be loaded before calling this function
+     */
+    inline const NNUEAccumulator& getAccumulator() {
+        if (accumulatorNetworkId != NNUE::getNetworkId()) refreshAccumulator();
+        return accumulator;
+    }
+
+    /**
+     * @brief Rebuilds the NNUE accumulator from the piece bitboards using the currently loaded network
+     */
+    void refreshAccumulator();
+
+    /**
+     * @brief Gets the game phase of the pieces on the board
+     * @return Game phase where 24 = early game, 0 = end game
+     * @attention This value is not capped and can exceed 24 after promotions
+     * @note This value is updated incrementally as pieces are added and removed
+     */
+    inline int16_t getPhase() const {
+        return phase;
+    }
+
     /**
      * @brief Gets the square of the pawn that just moved 2 steps forward
      * @return Square of the pawn that just moved 2 steps forward if it exists
@@ -146,6 +195,54 @@ public:
         return std::countr_zero(pieceBitboards[toIndex(colour)][toIndex(Piece::KING)]);
     }
 
+    /**
+     * @brief Gets the pieces of both colours which attack a square for a given occupancy of the board
+     * @param square Square to find the attackers of (0-63)
+     * @param occupiedBitboard Occupancy used to block slider attacks, pieces outside of it are treated as removed
+     * @return Bitboard of the pieces attacking the square
+     * @note There is no requirement that a piece occupies the square
+     */
+    Bitboard attackersTo(uint8_t square, Bitboard occupiedBitboard) const;
+
+    /**
+     * @brief Gets the pieces of both colours which attack a square
+     * @param square Square to find the attackers of (0-63)
+     * @return Bitboard of the pieces attacking the square
+     */
+    inline Bitboard attackersTo(uint8_t square) const {
+        return attackersTo(square, piecesBitboard);
+    }
+
+    /**
+     * @brief Gets every square attacked by a colour
+     * @param colour Colour of the attacking player
+     * @return Bitboard of the attacked squares
+     * @note This is computed once per position and cached until the pieces change
+     */
+    inline Bitboard attacksBy(Colour colour) const {
+        return cachedAttackInfo(ATTACKS_CACHED, colour, attackInfoStack.back().attacks);
+    }
+
+    /**
+     * @brief Gets the opposing pieces which give check to the king of a colour
+     * @param colour Colour of the king
+     * @return Bitboard of the checking pieces
+     * @note This is computed once per position and cached until the pieces change
+     */
+    inline Bitboard checkers(Colour colour) const {
+        return cachedAttackInfo(CHECKERS_CACHED, colour, attackInfoStack.back().checkers);
+    }
+
+    /**
+     * @brief Gets the pieces of a colour which are pinned to their own king by an opposing slider
+     * @param colour Colour of the pinned pieces
+     * @return Bitboard of the pinned pieces
+     * @note This is computed once per position and cached until the pieces change
+     */
+    inline Bitboard pinned(Colour colour) const {
+        return cachedAttackInfo(PINNED_CACHED, colour, attackInfoStack.back().pinned);
+    }
+
     /**
      * @brief Gets the squares that a colour occupies
      * @param colour Colour of player
@@ -407,11 +504,68 @@ private:
     std::array<Piece, 64> pieceCache;
     std::array<Colour, 64> colourCache;
 
+    std::array<int16_t, 2> materialScores; ///< Indexed as [colour]
+    std::array<Score, 2> pieceSquareScores; ///< Indexed as [colour]
+    int16_t phase;
+
+    NNUEAccumulator accumulator;
+    uint32_t accumulatorNetworkId = 0; ///< Network the accumulator was built with, 0 if the accumulator is not in use
+
+    /**
+     * Attack information of a single position, each entry is only valid once its flag is set in validFlags
+     */
+    struct AttackInfo {
+        Bitboard attacks[2]; ///< Indexed as [colour]
+        Bitboard checkers[2]; ///< Indexed as [colour]
+        Bitboard pinned[2]; ///< Indexed as [colour]
+        uint8_t validFlags = 0;
+    };
+
+    static constexpr uint8_t ATTACKS_CACHED = 0x1; ///< Shifted left by 3 * colour
+    static constexpr uint8_t CHECKERS_CACHED = 0x2; ///< Shifted left by 3 * colour
+    static constexpr uint8_t PINNED_CACHED = 0x4; ///< Shifted left by 3 * colour
+
+    /// One entry per move made, so that the attack information of a position is still cached after undoing a move from it
+    mutable std::vector<AttackInfo> attackInfoStack = std::vector<AttackInfo>(1);
+
+    /**
+     * @brief Gets an entry of the attack information of the current position, computing it if it is not cached
+     * @param flag Flag of the entry
+     * @param colour Colour of the entry
+     * @param entries Array of the entry in the attack information of the current position, indexed as [colour]
+     * @return Attack information entry
+     */
+    inline Bitboard cachedAttackInfo(uint8_t flag, Colour colour, Bitboard (&entries)[2]) const {
+        const uint8_t c = toIndex(colour);
+        const uint8_t colourFlag = flag << (3 * c);
+        AttackInfo& info = attackInfoStack.back();
+        if (!(info.validFlags & colourFlag)) {
+            entries[c] = computeAttackInfo(flag, colour);
+            info.validFlags |= colourFlag;
+        }
+
+        return entries[c];
+    }
+
+    /**
+     * @brief Computes an entry of the attack information of the current position
+     * @param flag Flag of the entry
+     * @param colour Colour of the entry
+     * @return Attack information entry
+     */
+    Bitboard computeAttackInfo(uint8_t flag, Colour colour) const;
+
     /**
      * @brief Resets the pieces back to their original starting position
      * @warning Does not reset en passant information, castling rights or turn control
      */
     void resetPieces();
+
+    /**
+     * @brief Recomputes material, piece square table scores and game phase from the piece bitboards and clears the cached attack information
+     * @note This should only be called when pieces are placed without using addPiece or removePiece
+     */
+    void recomputeScores();
 };
 
 #endif // BOARD_H
\ No newline at end of file
@@ -32,6 +32,7 @@ public:
      * @param board Board object representing current board state
      * @param colour Colour of king
      * @return True if in check, false otherwise
+     * @note Uses the checkers cached by the board so repeated calls on the same position are cheap
      */
     static bool isInCheck(const Board& board, Colour colour);
 
@@ -41,6 +42,7 @@ public:
      * @param colour Colour of piece occupying the square (opposite colour is the colour of pieces attacking that square)
      * @param targetSquare Square to check if it is in danger
      * @note There is no requirement that a piece occupies the square
+     * @note Uses the attack set cached by the board, so the castling checks of a position share one computation
      */
     static bool isInDanger(const Board& board, Colour colour, uint8_t targetSquare);
 
@@ -53,7 +55,7 @@ private:
      */
     static bool hasMove(Board& board, Colour colour);
 
-    inline static std::vector<Move> moveBuffer = [] {
+    inline static thread_local std::vector<Move> moveBuffer = [] {
         std::vector<Move> v;
         v.reserve(256);
         return v;
@@ -2,15 +2,83 @@
 #define ENGINE_H
 
 #include <vector>
+#include <array>
 #include <cstdint>
+#include <cstddef>
 #include <string>
+#include <limits>
 #include <unordered_map>
+#include <functional>
+#include <optional>
 #include "engine/transposition_table.h"
+#include "engine/evaluation.h"
 #include "move/move.h"
 #include "game/game.h"
 #include "board/board.h"
 #include "chess_types.h"
 
+/**
+ * Counters collected during a single search
+ */
+struct SearchStats {
+    uint64_t nodes = 0; ///< Number of negamax nodes visited
+    uint64_t quiescenceNodes = 0; ///< Number of quiescence nodes visited
+    uint64_t lateMovePrunes = 0; ///< Number of negamax nodes whose remaining quiet moves were skipped by late move pruning
+    uint64_t historyPrunes = 0; ///< Number of quiet moves skipped by history pruning
+    uint64_t singularExtensions = 0; ///< Number of transposition table moves extended as singular
+    uint64_t multiCuts = 0; ///< Number of negamax nodes cut off by the singular extension search
+    uint64_t probCuts = 0; ///< Number of negamax nodes cut off by a reduced search of a capture
+};
+
+/**
+ * Toggles and margins of the forward pruning done close to the horizon of negamax, and of ProbCut which is done far from it
+ * Margins are in centipawns, each pruning is only tried up to its maximum remaining depth
+ */
+struct PruningParameters {
+    bool reverseFutilityPruning = true;
+    int reverseFutilityMaxDepth = 6;
+    int16_t reverseFutilityMargin = 90; ///< Multiplied by the remaining depth
+
+    bool futilityPruning = true;
+    int futilityMaxDepth = 3;
+    int16_t futilityBaseMargin = 100;
+    int16_t futilityDepthMargin = 120; ///< Multiplied by the remaining depth and added to the base margin
+
+    bool razoring = true;
+    int razoringMaxDepth = 2;
+    int16_t razoringBaseMargin = 300;
+    int16_t razoringDepthMargin = 200; ///< Multiplied by the remaining depth and added to the base margin
+
+    bool lateMovePruning = true;
+    std::array<int, 5> lateMovePruningCounts = {0, 5, 8, 13, 20}; ///< Moves searched before the remaining quiet moves are skipped, indexed by remaining depth
+
+    bool historyPruning = true;
+    int historyPruningMaxDepth = 3;
+    int16_t historyPruningMargin = 512; ///< Quiet moves with a history score below minus this times the remaining depth are skipped
+
+    bool probCut = true;
+    int probCutMinDepth = 5; ///< Unlike the other pruning, ProbCut is only tried from this remaining depth upwards
+    int16_t probCutMargin = 100; ///< Captures must beat beta by this in the reduced search to cut off the node
+    int probCutReduction = 4; ///< Plies by which the search of each capture is reduced
+};
+
+/**
+ * Handling of negamax nodes which have no move from the transposition table to search first
+ */
+enum class InternalIterativeMode : uint8_t {
+    NONE = 0, ///< Search the node as normal
+    REDUCTION = 1 ///< Search the node one ply shallower
+};
+
+/**
+ * Plies of quiescence search which search quiet checks after the captures
+ */
+enum class QuiescenceChecksMode : uint8_t {
+    NONE = 0, ///< Only captures and queen promotions are searched outside of check
+    FIRST_PLY = 1, ///< Quiet checks are also searched at the first ply of quiescence search
+    ALL_PLIES = 2 ///< Quiet checks are also searched at every ply of quiescence search
+};
+
 class Engine {
 public:
     /**
@@ -18,8 +86,9 @@ public:
      * @param timeLimit Maximum time for search in ms
      * @param maxDepth Max depth for engine search
      * @param quiescenceDepth Max depth for quiescence search
+     * @param transpositionTableSize Size of the transposition table in MB
      */
-    Engine(int timeLimit, uint8_t maxDepth, uint8_t quiescenceDepth);
+    Engine(int timeLimit, uint8_t maxDepth, uint8_t quiescenceDepth, std::size_t transpositionTableSize = 256);
 
     /**
      * @brief Calculates the best move according to the engine
@@ -56,6 +125,56 @@ public:
         return previousMove;
     }
 
+    /**
+     * @brief Gets the counters collected during the last getMove call
+     * @return Search statistics of the last search
+     */
+    inline const SearchStats& getStats() const {
+        return stats;
+    }
+
+    /**
+     * @brief Limits the number of nodes (including quiescence nodes) searched per getMove call
+     * @param nodeLimit Maximum number of nodes to search, 0 for no limit
+     * @note The search stops at the same point as when the time limit is reached,
+     * so the best move of the last fully searched depth is returned
+     */
+    inline void setNodeLimit(uint64_t nodeLimit) {
+        this->nodeLimit = nodeLimit;
+    }
+
+    /**
+     * @brief Sets which forward pruning techniques negamax uses and their margins
+     * @param pruningParameters Forward pruning toggles and margins
+     */
+    inline void setPruningParameters(const PruningParameters& pruningParameters) {
+        pruning = pruningParameters;
+    }
+
+    /**
+     * @brief Sets how negamax handles nodes which have no transposition table move
+     * @param mode Internal iterative reduction or none
+     */
+    inline void setInternalIterativeMode(InternalIterativeMode mode) {
+        internalIterativeMode = mode;
+    }
+
+    /**
+     * @brief Sets the plies of quiescence search which search quiet checks
+     * @param mode No plies, only the first ply or every ply
+     */
+    inline void setQuiescenceChecksMode(QuiescenceChecksMode mode) {
+        quiescenceChecksMode = mode;
+    }
+
+    /**
+     * @brief Gets the forward pruning toggles and margins used by negamax
+     * @return Forward pruning toggles and margins
+     */
+    inline const PruningParameters& getPruningParameters() const {
+        return pruning;
+    }
+
 private:
     /**
      * @brief Searches through game tree to find the best evaluation for a player assuming optimal moves from both sides
@@ -65,13 +184,14 @@ private:
      * @param beta Minimax beta variable for alpha-beta pruning
      * @param state The current game state evaluation
      * @param isPVNode True if the parent call was a PV node, false otherwise
+     * @param cutNode True if the node is expected to fail high, which alternates between the plies of zero window searches
      * @param timeUp Function to check if current search time has exceeded
      * @param ply Number of half moves elapsed since the start of the search
      * @param extensionCount Number of extensions made
      * @param allowNullMove Allow null pruning
      * @return Evaluation of current game state at a specified depth
      */
-    int16_t negamax(Game& game, int depth, int16_t alpha, int16_t beta, GameStateEvaluation state, bool isPVNode,
+    int16_t negamax(Game& game, int depth, int16_t alpha, int16_t beta, GameStateEvaluation state, bool isPVNode, bool cutNode,
                     const std::function<bool()>& timeUp, uint8_t ply = 1, int extensionCount = 0, bool allowNullMove = true);
 
     /**
@@ -85,8 +205,23 @@ private:
      */
     int16_t quiescence(Game& game, int16_t alpha, int16_t beta, uint8_t qdepth, GameStateEvaluation state, uint8_t ply);
 
-    TranspositionTable transpositionTable;
-    TranspositionTable quiescenceTranspositionTable;
+    /**
+     * @brief Gets a copy of the transposition table entry of a position
+     * @param hash Zobrist hash of the position
+     * @return Copy of the entry, or std::nullopt if there is none
+     */
+    std::optional<TTEntry> probeTranspositionTable(uint64_t hash);
+
+    /**
+     * @brief Converts the remaining depth of a quiescence search into the depth of its transposition table entry
+     * @param qdepth Remaining depth of quiescence search
+     * @return 0 at the first ply of quiescence search and negative deeper, so that entries of any negamax search are deeper
+     */
+    inline int quiescenceEntryDepth(uint8_t qdepth) const {
+        return static_cast<int>(qdepth) - QUIESCENCE_DEPTH;
+    }
+
+    TranspositionTable transpositionTable; ///< Shared by negamax and quiescence search
 
     const int TIME_LIMIT;
     const uint8_t MAX_DEPTH;
@@ -94,14 +229,30 @@ private:
 
     static constexpr int16_t DELTA_MARGIN = 150;
     static constexpr int MAX_EXTENSION_COUNT = 5;
+    static constexpr std::size_t MAX_TRACKED_QUIETS = 64; // Quiet moves of a node which are penalised in the history table on a cutoff
+    static constexpr std::size_t MAX_TRACKED_CAPTURES = 32; // Captures of a node which are penalised in the capture history table on a cutoff
+    static constexpr int LMR_HISTORY_DIVISOR = 8192; // History score worth one ply of late move reduction
+    static constexpr int INTERNAL_ITERATIVE_MIN_DEPTH = 4;
+    static constexpr int SINGULAR_EXTENSION_MIN_DEPTH = 6;
+    static constexpr int SINGULAR_EXTENSION_TT_DEPTH_MARGIN = 3; // Transposition table entries this much shallower than the node are trusted
+    static constexpr int16_t SINGULAR_EXTENSION_MARGIN = 2; // Multiplied by the remaining depth and subtracted from the entry evaluation
+    static constexpr int16_t NO_STATIC_EVAL = std::numeric_limits<int16_t>::min(); // Static evaluation of a node in check
 
     std::vector<Move> moveBuffer;
     std::vector<std::vector<Move>> negamaxMoveBuffers;
     std::vector<std::vector<Move>> quiescenceMoveBuffers;
+    std::vector<int16_t> staticEvals; ///< Static evaluation of the negamax node at each ply of the current line
+    std::vector<Move> excludedMoves; ///< Move skipped by the singular extension search at each ply of the current line, Move() if none
+    std::vector<PreviousMove> playedMoves; ///< Move made at each ply of the current line, for the counter move and continuation history
 
+    uint64_t nodeLimit = 0;
+    PruningParameters pruning;
+    InternalIterativeMode internalIterativeMode = InternalIterativeMode::REDUCTION;
+    QuiescenceChecksMode quiescenceChecksMode = QuiescenceChecksMode::FIRST_PLY;
     uint8_t maxDepthSearched = 0;
     int16_t currentEvaluation = 0;
     Move previousMove;
+    SearchStats stats;
 };
 
 #endif // ENGINE_H
\ No newline at end of file
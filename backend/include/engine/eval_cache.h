@@ -0,0 +1,80 @@
+#ifndef EVAL_CACHE_H
+#define EVAL_CACHE_H
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+/**
+ * Direct-mapped cache of static evaluations keyed by Zobrist hash
+ * Each slot packs the upper 48 bits of the hash with the 16 bit evaluation so entries can be
+ * read and written in a single word. Collisions always overwrite the previous entry
+ */
+class EvalCache {
+public:
+    /**
+     * @brief Creates an evaluation cache
+     * @param size Size of evaluation cache in MB
+     * @note The size of the evaluation cache may be less than the specified number due to rounding for optimisation
+     */
+    EvalCache(std::size_t size);
+
+    /**
+     * @brief Stores an evaluation, always replacing the entry previously stored in its slot
+     * @param key Zobrist hash of the position
+     * @param eval Static evaluation of the position
+     */
+    inline void add(uint64_t key, int16_t eval) {
+        table[key & (TABLE_SIZE - 1)] = (key & KEY_MASK) | static_cast<uint16_t>(eval);
+    }
+
+    /**
+     * @brief Looks up the evaluation of a position
+     * @param key Zobrist hash of the position
+     * @param eval Set to the cached evaluation on a hit
+     * @return True if the position was found in the cache, otherwise false
+     */
+    inline bool probe(uint64_t key, int16_t& eval) {
+        probes++;
+        uint64_t slot = table[key & (TABLE_SIZE - 1)];
+
+        if (slot != 0 && (slot & KEY_MASK) == (key & KEY_MASK)) {
+            hits++;
+            eval = static_cast<int16_t>(slot & ~KEY_MASK);
+            return true;
+        }
+
+        return false;
+    }
+
+    /**
+     * @brief Clears all cache entries and resets the hit counters
+     */
+    void clear();
+
+    /**
+     * @brief Gets the number of probe calls since the last clear
+     * @return Number of probes
+     */
+    inline uint64_t getProbes() const {
+        return probes;
+    }
+
+    /**
+     * @brief Gets the number of probe calls which found an entry since the last clear
+     * @return Number of hits
+     */
+    inline uint64_t getHits() const {
+        return hits;
+    }
+
+private:
+    static constexpr uint64_t KEY_MASK = 0xFFFFFFFFFFFF0000ULL;
+
+    const std::size_t TABLE_SIZE;
+    std::vector<uint64_t> table;
+    uint64_t probes = 0;
+    uint64_t hits = 0;
+};
+
+#endif // EVAL_CACHE_H
\ No newline at end of file
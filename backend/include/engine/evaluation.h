@@ -2,11 +2,22 @@
 #define EVALUATION_H
 
 #include <cstdint>
+#include <cstddef>
 #include <cstring>
 #include <utility>
+#include <array>
+#include <algorithm>
+#include <cstdlib>
 #include "board/board.h"
 #include "move/move.h"
 #include "game/game.h"
+#include "engine/pawn_hash_table.h"
+#include "engine/eval_cache.h"
+#include "engine/evaluation_context.h"
+#include "engine/evaluation_trace.h"
+#include "engine/piece_tables.h"
+#include "engine/score.h"
+#include "engine/nnue.h"
 #include "chess_types.h"
 
 enum class MoveType : uint8_t {
@@ -17,7 +28,34 @@ enum class MoveType : uint8_t {
     HISTORY = 4
 };
 
+enum class EvaluationMode : uint8_t {
+    CLASSICAL = 0,
+    NNUE = 1
+};
+
+/**
+ * Counters of the windowed evaluate calls which were able to return the lazy evaluation
+ */
+struct LazyEvaluationStats {
+    uint64_t calls = 0; ///< Number of windowed evaluations which missed the evaluation cache
+    uint64_t exits = 0; ///< Number of those which returned early with the lazy evaluation
+};
+
+/**
+ * A move made earlier in the search, identified by the piece that moved and its target square
+ * Indexes the counter move and continuation history tables
+ */
+struct PreviousMove {
+    Chess::PieceType piece = Chess::PieceType::NONE; ///< NONE if there was no move (before the root or a null move)
+    uint8_t toSquare = 0;
+};
+
+/// Moves made one and two plies before a search node, indexed by the number of plies ago minus one
+using PreviousMoves = std::array<PreviousMove, 2>;
+
 class Evaluation {
+    friend class Tuner; // Reads the evaluation weights as the starting point of tuning
+
 public:
     using Piece = Chess::PieceType;
     using Colour = Chess::PieceColour;
@@ -26,10 +64,18 @@ public:
      * @brief Calculates the evaluation of the players pieces
      * @param board Board object representing current board state
      * @param colour Colour of player
-     * @param phase Current game phase (0-24) with 24 = early game, 0 = end game
-     * @return Evaluation of players pieces
+     * @param pawnEntry Cached pawn structure evaluation of the current position
+     * @param context Attack maps of both colours for the current position
+     * @return Packed early game and end game evaluation of players pieces
      */
-    static int16_t pieceValueEvaluation(Board& board, Colour colour, int16_t phase);
+    static Score pieceValueEvaluation(Board& board, Colour colour, const PawnHashEntry& pawnEntry, const EvaluationContext& context);
+
+    /**
+     * @brief Computes the attack maps of both colours in a single pass
+     * @param board Board object representing current board state
+     * @param context Evaluation context to write the attack maps into
+     */
+    static void buildEvaluationContext(Board& board, EvaluationContext& context);
 
     /**
      * @brief Orders moves by predicted best to worse for normal negamax search
@@ -42,12 +88,47 @@ public:
     static void orderMoves(std::vector<Move>& moves, Board& board, uint8_t ply, Colour colour, const Move* bestMove = nullptr);
 
     /**
-     * @brief Orders moves by predicted best to worse for quiescence search
-     * @param moves Moves vector to sort
+     * @brief Calculates the ordering score of a capture or queen promotion
+     * @param move Capture or queen promotion move
      * @param board Board object representing current board state
-     * @param bestMove Best move from previous depth if any
+     * @return MVV-LVA score of the capture adjusted by its capture history with a bonus for queen promotions,
+     * higher scores should be searched first
+     */
+    static int32_t captureOrderingScore(const Move move, Board& board);
+
+    /**
+     * @brief Checks if the static exchange evaluation of a move reaches a threshold
+     * Captures on the target square are played out with the least valuable attacker of each side,
+     * where either side may stop capturing when continuing would lose material
+     * @param board Board object representing current board state
+     * @param move Move to evaluate
+     * @param threshold Material that the player making the move must at least gain
+     * @return True if the exchange started by the move gains at least threshold, otherwise false
+     * @note Promotions and pinned attackers are not taken into account
+     */
+    static bool staticExchangeAtLeast(Board& board, const Move move, int16_t threshold = 0);
+
+    /**
+     * @brief Calculates the ordering score of a quiet move from the history heuristic and continuation history tables
+     * @param move Quiet move
+     * @param piece Piece that is moving
+     * @param colour Colour of the player making the move
+     * @param previousMoves Moves made one and two plies before the move
+     * @return History score of the move, higher scores should be searched first
      */
-    static void orderQuiescenceMoves(std::vector<Move>& moves, Board& board);
+    static inline int32_t historyOrderingScore(const Move move, Piece piece, Colour colour, const PreviousMoves& previousMoves) {
+        const uint8_t c = Chess::toIndex(colour);
+        const uint8_t p = Chess::toIndex(piece);
+        const uint8_t toSquare = move.getToSquare();
+        int32_t score = historyHeuristics[c][p][move.getFromSquare()][toSquare];
+
+        for (uint8_t i = 0; i < 2; i++) {
+            if (previousMoves[i].piece == Piece::NONE) continue;
+            score += continuationHistory[c][i][Chess::toIndex(previousMoves[i].piece)][previousMoves[i].toSquare][p][toSquare];
+        }
+
+        return score;
+    }
 
     /**
      * @brief Evaluates the current game state
@@ -58,6 +139,83 @@ public:
      */
     static int16_t evaluate(Game& game, GameStateEvaluation state, uint8_t ply);
 
+    /**
+     * @brief Evaluates the current game state, returning early from the lazy evaluation (material and piece square tables)
+     * when it is so far outside of the alpha-beta window that the remaining terms are unlikely to bring it back inside
+     * @param game Game object
+     * @param state The current game state evaluation
+     * @param ply Number of half moves elapsed since the start of the search
+     * @param alpha Minimax alpha variable for alpha-beta pruning
+     * @param beta Minimax beta variable for alpha-beta pruning
+     * @return Evaluation of current game state (at depth 0), or on an early exit the lazy evaluation moved by the margin
+     * towards the window, which is the least extreme value the remaining terms are expected to allow
+     * @note Early exits are not stored in the evaluation cache and never happen with the NNUE evaluation
+     */
+    static int16_t evaluate(Game& game, GameStateEvaluation state, uint8_t ply, int16_t alpha, int16_t beta);
+
+    /**
+     * @brief Evaluates the current position with the selected evaluation mode without consulting the evaluation cache
+     * @param game Game object
+     * @return Static evaluation of the current position from the perspective of the player to move
+     * @note Falls back to the classical evaluation if the NNUE mode is selected but no network is loaded
+     */
+    static int16_t staticEvaluation(Game& game);
+
+    /**
+     * @brief Selects the evaluation used by evaluate
+     * @param mode Classical handcrafted evaluation or NNUE
+     * @note This clears the evaluation cache
+     */
+    static void setEvaluationMode(EvaluationMode mode);
+
+    /**
+     * @brief Gets the selected evaluation mode
+     * @return Selected evaluation mode
+     */
+    static inline EvaluationMode getEvaluationMode() {
+        return evaluationMode;
+    }
+
+    /**
+     * @brief Checks if an evaluation is a forced checkmate score
+     * @param eval Evaluation to check
+     * @return True if the evaluation is a checkmate for either player, otherwise false
+     */
+    static inline bool isMateScore(int16_t eval) {
+        return eval >= CHECKMATE_VALUE - MAX_MATE_PLY || eval <= -CHECKMATE_VALUE + MAX_MATE_PLY;
+    }
+
+    /**
+     * @brief Enables or disables the early exit of the windowed evaluate
+     * @param enabled True to allow returning the lazy evaluation outside of the window, false to always evaluate fully
+     */
+    static inline void setLazyEvaluation(bool enabled) {
+        lazyEvaluationEnabled = enabled;
+    }
+
+    /**
+     * @brief Checks if the windowed evaluate may exit early
+     * @return True if lazy evaluation is enabled, otherwise false
+     */
+    static inline bool isLazyEvaluationEnabled() {
+        return lazyEvaluationEnabled;
+    }
+
+    /**
+     * @brief Gets the lazy evaluation counters of this thread since the last clearLazyEvaluationStats
+     * @return Reference to the lazy evaluation counters
+     */
+    static inline const LazyEvaluationStats& getLazyEvaluationStats() {
+        return lazyEvaluationStats;
+    }
+
+    /**
+     * @brief Resets the lazy evaluation counters of this thread
+     */
+    static inline void clearLazyEvaluationStats() {
+        lazyEvaluationStats = {};
+    }
+
     /**
      * @brief Gets the value of a piece
      * @param piece Piece (0 = pawn, 1 = knight, 2 = bishop, 3 = rook, 4 = queen)
@@ -89,97 +247,269 @@ public:
     static bool isKillerMove(Move move, uint8_t ply);
 
     /**
-     * @brief Adds the given move to the history heuristic table
-     * @param move Move to add to the table
+     * @brief Gets a killer move of the given ply
+     * @param ply Number of half move elapsed since the start of the search
+     * @param index 0 for the most recent killer move, 1 for the older killer move
+     * @return Killer move, or the null move Move() if there is none
+     */
+    static inline Move getKillerMove(uint8_t ply, uint8_t index) {
+        return killerMoves[ply][index];
+    }
+
+    /**
+     * @brief Updates the history heuristic and continuation history tables for a quiet move
+     * @param move Quiet move to update
      * @param piece Piece that is moving
      * @param colour Colour of the player that made the move
-     * @param depth Depth remaining of the search at the point of adding the history heuristic
+     * @param previousMoves Moves made one and two plies before the move
+     * @param depth Depth remaining of the search at the point of the update
+     * @param causedCutoff True if the move caused a cutoff, false if it was searched before another move that did
+     * @note Entries move towards +-MAX_HISTORY_VALUE by a fraction of their distance from it so they never saturate
+     */
+    static void updateHistory(Move move, Piece piece, Colour colour, const PreviousMoves& previousMoves, int depth, bool causedCutoff);
+
+    /**
+     * @brief Updates the capture history table for a capture
+     * @param move Capture to update
+     * @param piece Piece that is capturing
+     * @param colour Colour of the player that made the capture
+     * @param depth Depth remaining of the search at the point of the update, 1 in quiescence search
+     * @param causedCutoff True if the capture caused a cutoff, false if it was searched before another move that did
+     */
+    static void updateCaptureHistory(Move move, Piece piece, Colour colour, int depth, bool causedCutoff);
+
+    /**
+     * @brief Gets the move which last caused a cutoff in reply to a previous move
+     * @param colour Colour of the player replying to the previous move
+     * @param previousMove Move being replied to
+     * @return Counter move, or the null move Move() if there is none
+     */
+    static inline Move getCounterMove(Colour colour, const PreviousMove& previousMove) {
+        if (previousMove.piece == Piece::NONE) return Move();
+        return counterMoves[Chess::toIndex(colour)][Chess::toIndex(previousMove.piece)][previousMove.toSquare];
+    }
+
+    /**
+     * @brief Sets the move which caused a cutoff in reply to a previous move
+     * @param colour Colour of the player replying to the previous move
+     * @param previousMove Move being replied to
+     * @param move Quiet move which caused the cutoff
+     */
+    static inline void setCounterMove(Colour colour, const PreviousMove& previousMove, Move move) {
+        if (previousMove.piece == Piece::NONE) return;
+        counterMoves[Chess::toIndex(colour)][Chess::toIndex(previousMove.piece)][previousMove.toSquare] = move;
+    }
+
+    /**
+     * @brief Adjusts a static evaluation by the error that searches have measured for the pawn structure of the position
+     * @param staticEval Static evaluation of the position from the perspective of the player to move
+     * @param colour Colour of the player to move
+     * @param pawnHash Zobrist hash of the current pawn structure
+     * @return Corrected static evaluation, which is never a checkmate score
+     */
+    static inline int16_t correctStaticEval(int16_t staticEval, Colour colour, uint64_t pawnHash) {
+        const int correction = pawnCorrectionHistory[Chess::toIndex(colour)][pawnHash & (CORRECTION_HISTORY_SIZE - 1)] / CORRECTION_HISTORY_GRAIN;
+        return static_cast<int16_t>(std::clamp(staticEval + correction, -CHECKMATE_VALUE + MAX_MATE_PLY + 1, CHECKMATE_VALUE - MAX_MATE_PLY - 1));
+    }
+
+    /**
+     * @brief Moves the correction history entry of a pawn structure towards the error of a static evaluation
+     * @param colour Colour of the player to move
+     * @param pawnHash Zobrist hash of the current pawn structure
+     * @param depth Depth of the completed search, deeper searches move the entry further
+     * @param searchEval Result of the search from the perspective of the player to move
+     * @param staticEval Uncorrected static evaluation of the position from the perspective of the player to move
+     * @note The caller should only update when the search result is an exact score or a bound beyond the static evaluation
      */
-    static void addHistoryHeuristic(Move move, Piece piece, Colour colour, uint8_t depth);
+    static void updateCorrectionHistory(Colour colour, uint64_t pawnHash, int depth, int16_t searchEval, int16_t staticEval);
 
     /**
-     * @brief Ages each entry inside of the table to prevent stale entries
+     * @brief Ages each entry inside of the history heuristic, continuation history and capture history tables to prevent stale entries
      * @note This function should be called after every search
      */
     static void ageHistoryHeuristicsTable();
 
     /**
-     * @brief Clears the history heuristics table
+     * @brief Clears the history heuristic, continuation history, capture history, counter move and correction history tables
      * @note This funcion should not often be called and instead values should be aged
      */
     static void clearHistoryHeuristicsTable();
 
+    /**
+     * @brief Gets the pawn hash table used to cache pawn structure evaluations
+     * @return Reference to the pawn hash table
+     */
+    static inline const PawnHashTable& getPawnHashTable() {
+        return pawnHashTable;
+    }
+
+    /**
+     * @brief Gets the cache of static evaluations consulted by evaluate
+     * @return Reference to the evaluation cache
+     */
+    static inline const EvalCache& getEvalCache() {
+        return evalCache;
+    }
+
+    /**
+     * @brief Clears the evaluation cache and pawn hash table of this thread along with their hit counters
+     */
+    static void clearEvaluationCaches();
+
+#ifdef EVALUATION_TRACE
+    /**
+     * @brief Gets the term counts collected by the classical evaluations on this thread since the last clearTrace
+     * @return Reference to the evaluation trace
+     */
+    static inline const EvaluationTrace& getTrace() {
+        return trace;
+    }
+
+    /**
+     * @brief Resets the term counts of the evaluation trace of this thread
+     */
+    static inline void clearTrace() {
+        trace = {};
+    }
+#endif
+
 private:
     static std::pair<MoveType, int16_t> orderingScore(const Move move, Board& board, uint8_t ply, Colour colour, const Move* bestMove = nullptr);
-    static int16_t orderingQuiescenceScore(const Move move, Board& board);
     static int16_t gamePhase(Board& board);
 
-    static constexpr int16_t CHECKMATE_VALUE = 30000;
+    /**
+     * @brief Evaluates only the material and piece square tables, which are maintained incrementally by the board
+     * @param game Game object
+     * @return Lazy evaluation of the current position from the perspective of the player to move
+     */
+    static int16_t lazyEvaluation(Game& game);
 
-    static constexpr int16_t PAWN_VALUE = 100;
-    static constexpr int16_t KNIGHT_VALUE = 320;
-    static constexpr int16_t BISHOP_VALUE = 330;
-    static constexpr int16_t ROOK_VALUE = 500;
-    static constexpr int16_t QUEEN_VALUE = 900;
-    static constexpr int16_t KING_VALUE = 10000;
+    /**
+     * @brief Evaluates the terms which depend only on the pawn structure for one colour
+     * @param board Board object representing current board state
+     * @param colour Colour of player
+     * @param entry Pawn hash entry to write the scores and pawn bitboards of the colour into
+     */
+    static void evaluatePawnStructure(Board& board, Colour colour, PawnHashEntry& entry);
+
+    /**
+     * @brief Gets the pawn structure evaluation from the pawn hash table, computing and storing it on a miss
+     * @param board Board object representing current board state
+     * @param pawnHash Zobrist hash of the current pawn structure
+     * @return Pawn hash entry for the current pawn structure
+     */
+    static const PawnHashEntry& probePawnStructure(Board& board, uint64_t pawnHash);
+
+    static constexpr int16_t CHECKMATE_VALUE = 30000;
+    static constexpr int16_t MAX_MATE_PLY = 256; // Checkmate scores are offset by at most the ply of the mate
+    static constexpr int16_t MAX_NNUE_EVALUATION = 20000;
+    // Typical size of the terms excluded from the lazy evaluation (about the 99th percentile over the bench positions), not a strict bound
+    static constexpr int16_t LAZY_EVALUATION_TYPICAL_MARGIN = 300;
+
+    static constexpr int16_t PAWN_VALUE = PieceTables::pieceValues[0];
+    static constexpr int16_t KNIGHT_VALUE = PieceTables::pieceValues[1];
+    static constexpr int16_t BISHOP_VALUE = PieceTables::pieceValues[2];
+    static constexpr int16_t ROOK_VALUE = PieceTables::pieceValues[3];
+    static constexpr int16_t QUEEN_VALUE = PieceTables::pieceValues[4];
+    static constexpr int16_t KING_VALUE = PieceTables::pieceValues[5];
     static constexpr int16_t pieceEvals[6] = {PAWN_VALUE, KNIGHT_VALUE, BISHOP_VALUE, ROOK_VALUE, QUEEN_VALUE, KING_VALUE};
 
     static constexpr int16_t PROMOTION_ORDERING_VALUE = 9000;
 
-    static constexpr int16_t DOUBLED_PAWN_PENALTY = -8;
-    static constexpr int16_t DOUBLED_PAWN_PENALTY_END_GAME = -12;
-    static constexpr int16_t ISOLATED_PAWN_PENALTY = -12;
-    static constexpr int16_t ISOLATED_PAWN_PENALTY_END_GAME = -20;
-    static constexpr int16_t BACKWARD_PAWN_PENALTY = -10;
-    static constexpr int16_t BACKWARD_PAWN_PENALTY_END_GAME = -15;
+    static constexpr Score DOUBLED_PAWN_PENALTY = Score(-8, -12);
+    static constexpr Score ISOLATED_PAWN_PENALTY = Score(-12, -20);
+    static constexpr Score BACKWARD_PAWN_PENALTY = Score(-10, -15);
 
-    static constexpr int16_t PAWN_CHAIN_BONUS = 3;
-    static constexpr int16_t PAWN_CHAIN_BONUS_END_GAME = 6;
+    static constexpr Score PAWN_CHAIN_BONUS = Score(3, 6);
 
-    static constexpr int16_t MAJOR_PAWN_SHIELD_BONUS = 30;
-    static constexpr int16_t MINOR_PAWN_SHIELD_BONUS = 20;
+    static constexpr Score MAJOR_PAWN_SHIELD_BONUS = Score(30, 0);
+    static constexpr Score MINOR_PAWN_SHIELD_BONUS = Score(20, 0);
 
     static constexpr int16_t MAX_TROPISM_DISTANCE = 4;
-    static constexpr int16_t KING_TROPISM_QUEEN_BONUS = 8;
-    static constexpr int16_t KING_TROPISM_ROOK_BONUS = 4;
-    static constexpr int16_t KING_TROPISM_KNIGHT_BONUS = 5;
-    static constexpr int16_t KING_TROPISM_BISHOP_BONUS = 2;
-    static constexpr int16_t KING_TROPISM_BONUSES[4] = {KING_TROPISM_KNIGHT_BONUS, KING_TROPISM_BISHOP_BONUS, 
-                                                          KING_TROPISM_ROOK_BONUS, KING_TROPISM_QUEEN_BONUS};
+    static constexpr Score KING_TROPISM_QUEEN_BONUS = Score(8, 0);
+    static constexpr Score KING_TROPISM_ROOK_BONUS = Score(4, 0);
+    static constexpr Score KING_TROPISM_KNIGHT_BONUS = Score(5, 0);
+    static constexpr Score KING_TROPISM_BISHOP_BONUS = Score(2, 0);
+    static constexpr Score KING_TROPISM_BONUSES[4] = {KING_TROPISM_KNIGHT_BONUS, KING_TROPISM_BISHOP_BONUS, 
+                                                        KING_TROPISM_ROOK_BONUS, KING_TROPISM_QUEEN_BONUS};
+
+    static constexpr Score ROOK_OPEN_FILE_BONUS = Score(30, 20);
+    static constexpr Score ROOK_SEMI_OPEN_FILE_BONUS = Score(15, 10);
+
+    static constexpr Score QUEEN_OPEN_FILE_BONUS = Score(15, 10);
+    static constexpr Score QUEEN_SEMI_OPEN_FILE_BONUS = Score(8, 5);
 
-    static constexpr int16_t ROOK_OPEN_FILE_BONUS = 30;
-    static constexpr int16_t ROOK_OPEN_FILE_BONUS_END_GAME = 20;
-    static constexpr int16_t ROOK_SEMI_OPEN_FILE_BONUS = 15;
-    static constexpr int16_t ROOK_SEMI_OPEN_FILE_BONUS_END_GAME = 10;
+    static constexpr Score OPEN_FILE_NEAR_KING_PENALTY = Score(-25, 0);
+    static constexpr Score SEMI_OPEN_FILE_NEAR_KING_PENALTY = Score(-15, 0);
 
-    static constexpr int16_t QUEEN_OPEN_FILE_BONUS = 15;
-    static constexpr int16_t QUEEN_OPEN_FILE_BONUS_END_GAME = 10;
-    static constexpr int16_t QUEEN_SEMI_OPEN_FILE_BONUS = 8;
-    static constexpr int16_t QUEEN_SEMI_OPEN_FILE_BONUS_END_GAME = 5;
+    static constexpr Score KING_ZONE_ATTACK_PENALTIES[5] = {Score(-10, 0), Score(-16, 0), Score(-12, 0), Score(-20, 0), Score(-30, 0)};
 
-    static constexpr int16_t OPEN_FILE_NEAR_KING_PENALTY = -25;
-    static constexpr int16_t SEMI_OPEN_FILE_NEAR_KING_PENALTY = -15;
+    static constexpr Score BISHOP_MOBILITY_BONUSES[14] = {
+        Score(-20, -25), Score(-10, -15), Score(-5, -10), Score(0, -5), Score(5, 0), Score(10, 5), Score(15, 10),
+        Score(20, 15), Score(25, 20), Score(30, 25), Score(35, 30), Score(40, 35), Score(45, 40), Score(50, 45)
+    };
 
-    static constexpr int16_t KING_ZONE_ATTACK_PENALTIES[5] = {-10, -16, -12, -20, -30};
+    static constexpr Score KNIGHT_MOBILITY_BONUSES[9] = {
+        Score(-25, -30), Score(-15, -20), Score(-10, -15), Score(-5, -10), Score(0, -5),
+        Score(8, 0), Score(15, 8), Score(22, 15), Score(30, 25)
+    };
 
-    static constexpr int16_t BISHOP_MOBILITY_BONUSES[14] = {-20, -10, -5, 0, 5, 10, 15, 20, 25, 30, 35, 40, 45, 50};
-    static constexpr int16_t BISHOP_MOBILITY_BONUSES_END_GAME[14] = {-25, -15, -10, -5, 0, 5, 10, 15, 20, 25, 30, 35, 40, 45};
+    static constexpr Score CONNECTED_ROOK_BONUS = Score(20, 30);
 
-    static constexpr int16_t KNIGHT_MOBILITY_BONUSES[9] = {-25, -15, -10, -5, 0, 8, 15, 22, 30};
-    static constexpr int16_t KNIGHT_MOBILITY_BONUSES_END_GAME[9] = {-30, -20, -15, -10, -5, 0, 8, 15, 25};
+    static constexpr Score PAWN_STORM_BONUS = Score(50, 0);
+    static constexpr Score PAWN_STORM_PROXIMITY_BONUS = Score(15, 0);
 
-    static constexpr int16_t CONNECTED_ROOK_BONUS = 20;
-    static constexpr int16_t CONNECTED_ROOK_BONUS_END_GAME = 30;
+    static constexpr int16_t MAX_HISTORY_VALUE = 8192;
+    static constexpr int MAX_HISTORY_BONUS = 1536;
+    static constexpr int CAPTURE_HISTORY_DIVISOR = 8; // Scales capture history so that a saturated entry is worth about a pawn of victim in the MVV-LVA score
 
-    static constexpr int16_t PAWN_STORM_BONUS = 50;
-    static constexpr int16_t PAWN_STORM_PROXIMITY_BONUS = 15;
+    /**
+     * @brief Moves a history table entry towards the limit in the direction of an update, by less the closer it already is
+     * @param entry History table entry to update
+     * @param update Bonus if positive, malus if negative
+     */
+    static inline void applyHistoryGravity(int16_t& entry, int update) {
+        entry += update - entry * std::abs(update) / MAX_HISTORY_VALUE;
+    }
+
+    /**
+     * @brief Calculates the bonus or malus of a history update
+     * @param depth Depth remaining of the search at the point of the update
+     * @param causedCutoff True for a bonus, false for a malus
+     * @return Update to apply to history table entries
+     */
+    static inline int historyUpdate(int depth, bool causedCutoff) {
+        const int bonus = std::min(16 * depth * depth, MAX_HISTORY_BONUS);
+        return causedCutoff ? bonus : -bonus;
+    }
 
-    static constexpr int16_t MAX_HISTORY_VALUE = 128;
+    static constexpr std::size_t CORRECTION_HISTORY_SIZE = 16384; // Entries per colour, must be a power of 2
+    static constexpr int CORRECTION_HISTORY_GRAIN = 256; // Entries are stored in 1/256ths of a centipawn
+    static constexpr int CORRECTION_HISTORY_WEIGHT_SCALE = 256;
+    static constexpr int MAX_CORRECTION_HISTORY_WEIGHT = 16;
+    static constexpr int MAX_CORRECTION_HISTORY_VALUE = 64 * CORRECTION_HISTORY_GRAIN;
 
     static constexpr int MAX_PHASE = 24;
 
-    static Move killerMoves[256][2];
-    static int16_t historyHeuristics[2][6][64][64];
+    static constexpr std::size_t PAWN_HASH_TABLE_SIZE = 2; // Size in MB
+    static constexpr std::size_t EVAL_CACHE_SIZE = 8; // Size in MB
+
+    // Search heuristics and caches are kept per thread so that independent searches can run concurrently
+    static thread_local Move killerMoves[256][2];
+    static thread_local int16_t historyHeuristics[2][6][64][64];
+    static thread_local int16_t continuationHistory[2][2][6][64][6][64]; // Indexed as [colour][plies ago - 1][previous piece][previous to][piece][to]
+    static thread_local Move counterMoves[2][6][64]; // Indexed as [colour][previous piece][previous to]
+    static thread_local int16_t captureHistory[2][6][64][6]; // Indexed as [colour][piece][to][captured piece]
+    static thread_local int16_t pawnCorrectionHistory[2][CORRECTION_HISTORY_SIZE]; // Indexed as [colour][pawn hash]
+    static thread_local PawnHashTable pawnHashTable;
+    static thread_local EvalCache evalCache;
+    static EvaluationMode evaluationMode;
+    static bool lazyEvaluationEnabled;
+    static thread_local LazyEvaluationStats lazyEvaluationStats;
+
+#ifdef EVALUATION_TRACE
+    static thread_local EvaluationTrace trace;
+#endif
 };
 
 #endif // EVALUATION_H
\ No newline at end of file
@@ -0,0 +1,32 @@
+#ifndef EVALUATION_CONTEXT_H
+#define EVALUATION_CONTEXT_H
+
+#include <cstdint>
+#include "chess_types.h"
+
+/**
+ * Attacks of a single non-pawn piece
+ */
+struct PieceAttacks {
+    Chess::Bitboard attacks;
+    uint8_t square;
+    Chess::PieceType piece;
+};
+
+/**
+ * Attack information for both colours computed once per evaluation
+ * Every evaluation term which needs to know what a piece attacks should read it from here
+ * rather than performing its own move table or slider lookups
+ */
+struct EvaluationContext {
+    static constexpr uint8_t MAX_PIECES = 16;
+
+    Chess::Bitboard attacks[2][6]; ///< Squares attacked by each piece type, indexed as [colour][piece]
+    Chess::Bitboard attackedBy[2]; ///< Squares attacked by any piece, indexed as [colour]
+    uint8_t kingZoneAttacks[2][6]; ///< Number of attacks into the opposing king zone by each piece type, indexed as [colour][piece]
+
+    PieceAttacks pieceAttacks[2][MAX_PIECES]; ///< Attacks of each knight, bishop, rook and queen, indexed as [colour][i]
+    uint8_t pieceAttacksCount[2]; ///< Number of valid pieceAttacks entries, indexed as [colour]
+};
+
+#endif // EVALUATION_CONTEXT_H
\ No newline at end of file
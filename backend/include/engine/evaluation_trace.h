@@ -0,0 +1,43 @@
+#ifndef EVALUATION_TRACE_H
+#define EVALUATION_TRACE_H
+
+#include <cstdint>
+
+/**
+ * Number of times each term of the classical evaluation was applied to a position, indexed as [...][colour]
+ * Every term of the classical evaluation is linear in its weight, so the evaluation of a position is the sum of
+ * each count multiplied by the packed weight of its term. The tuner uses this to evaluate positions without
+ * running the evaluation again for every change of the weights
+ * @note Counts are only collected when the backend is compiled with EVALUATION_TRACE defined
+ */
+struct EvaluationTrace {
+    int16_t pieceSquares[6][64][2]; ///< Indexed as [piece][table square][colour]
+    int16_t passedPawns[64][2]; ///< Indexed as [table square][colour]
+    int16_t doubledPawns[2];
+    int16_t isolatedPawns[2];
+    int16_t backwardPawns[2];
+    int16_t pawnChains[2];
+    int16_t majorPawnShields[2];
+    int16_t minorPawnShields[2];
+    int16_t kingTropism[4][2]; ///< Indexed as [knight, bishop, rook, queen][colour]
+    int16_t rookOpenFiles[2];
+    int16_t rookSemiOpenFiles[2];
+    int16_t queenOpenFiles[2];
+    int16_t queenSemiOpenFiles[2];
+    int16_t openFilesNearKing[2];
+    int16_t semiOpenFilesNearKing[2];
+    int16_t kingZoneAttacks[5][2]; ///< Indexed as [attacking piece][colour]
+    int16_t bishopMobility[14][2]; ///< Indexed as [mobility][colour]
+    int16_t knightMobility[9][2]; ///< Indexed as [mobility][colour]
+    int16_t connectedRooks[2];
+    int16_t pawnStorms[2];
+    int16_t pawnStormProximity[2];
+};
+
+#ifdef EVALUATION_TRACE
+#define TRACE_TERM(term, count) (Evaluation::trace.term += (count))
+#else
+#define TRACE_TERM(term, count) ((void)0)
+#endif
+
+#endif // EVALUATION_TRACE_H
\ No newline at end of file
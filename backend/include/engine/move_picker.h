@@ -0,0 +1,138 @@
+#ifndef MOVE_PICKER_H
+#define MOVE_PICKER_H
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include <vector>
+#include "board/board.h"
+#include "engine/evaluation.h"
+#include "move/move.h"
+#include "chess_types.h"
+
+enum class MovePickerStage : uint8_t {
+    TT_MOVE = 0,
+    GENERATE_CAPTURES = 1,
+    CAPTURES = 2,
+    KILLERS = 3,
+    COUNTER_MOVE = 4,
+    GENERATE_QUIETS = 5,
+    QUIETS = 6,
+    BAD_CAPTURES = 7,
+    GENERATE_QUIET_CHECKS = 8,
+    QUIET_CHECKS = 9,
+    GENERATE_EVASIONS = 10,
+    EVASIONS = 11,
+    DONE = 12
+};
+
+/**
+ * Yields the pseudo legal moves of a position one at a time in predicted best to worse order
+ * Moves are generated in stages only when the previous stage has been exhausted, so a node which cuts off
+ * on the transposition table move or an early capture never generates or scores the remaining moves
+ * Each stage is ordered by incremental selection of the highest scoring remaining move rather than a full sort
+ * Moves which do not come from the generator (transposition table, killer and counter moves) are only yielded if they are pseudo legal
+ *
+ * Negamax order: transposition table move, winning and equal captures and queen promotions (MVV-LVA and capture history), killer moves,
+ * counter move, quiet moves (history and continuation history), losing captures (MVV-LVA)
+ * Quiescence order: transposition table move, winning and equal captures and queen promotions (MVV-LVA and capture history),
+ * quiet checks which do not lose material if enabled
+ * Losing captures and checks are decided by static exchange evaluation and are not yielded at all by the quiescence order
+ * Quiescence order in check: transposition table move, evasions (captures by MVV-LVA and capture history, then quiet moves by history)
+ */
+class MovePicker {
+public:
+    using Piece = Chess::PieceType;
+    using Colour = Chess::PieceColour;
+
+    /**
+     * @brief Creates a move picker for negamax search
+     * @param board Board object representing current board state
+     * @param colour Colour of player making the moves
+     * @param ttMove Best move from the transposition table, or Move() if there is none
+     * @param ply Number of half moves elapsed since the start of the search
+     * @param previousMoves Moves made one and two plies before the position, used for the counter move and continuation history
+     * @param moves Buffer to generate moves into, this must not be used by any other search node until the picker is done
+     */
+    MovePicker(Board& board, Colour colour, Move ttMove, uint8_t ply, const PreviousMoves& previousMoves, std::vector<Move>& moves);
+
+    /**
+     * @brief Creates a move picker for quiescence search
+     * @param board Board object representing current board state
+     * @param colour Colour of player making the moves
+     * @param ttMove Best move from the transposition table, or Move() if there is none
+     * @param moves Buffer to generate moves into, this must not be used by any other search node until the picker is done
+     * @param inCheck True if the player to move is in check, in which case every evasion is yielded
+     * @param quietChecks True to yield quiet checks after the captures, ignored in check
+     */
+    MovePicker(Board& board, Colour colour, Move ttMove, std::vector<Move>& moves, bool inCheck, bool quietChecks);
+
+    /**
+     * @brief Gets the next move to search
+     * @return Next pseudo legal move, or the null move Move() once all moves have been yielded
+     * @warning Moves may leave the king in check and must be checked for legality by the caller
+     */
+    Move nextMove();
+
+    /**
+     * @brief Stops the picker from yielding any further quiet moves, including killer and counter moves
+     * @note Losing captures are still yielded after the skipped quiet moves
+     */
+    inline void skipQuiets() {
+        skipQuietMoves = true;
+    }
+
+    /**
+     * @brief Gets the current stage of the picker
+     * @return Stage that the last move was yielded from
+     */
+    inline MovePickerStage getStage() const {
+        return stage;
+    }
+
+private:
+    /**
+     * @brief Swaps the highest scoring move in the current stage to the front of the remaining moves
+     * @return Highest scoring remaining move
+     */
+    Move selectBest();
+
+    /**
+     * @brief Scores the captures and queen promotions generated from index current onwards
+     */
+    void scoreCaptures();
+
+    /**
+     * @brief Scores the quiet moves generated from index current onwards
+     */
+    void scoreQuiets();
+
+    /**
+     * @brief Scores the evasions generated from index current onwards, captures before quiet moves
+     */
+    void scoreEvasions();
+
+    static constexpr std::size_t MAX_MOVES = 256;
+    static constexpr int32_t EVASION_CAPTURE_BONUS = 1 << 16; // Above any history score so that captures are searched first
+
+    Board& board;
+    const Colour colour;
+    const Move ttMove;
+    const Move killerMoves[2];
+    const Move counterMove;
+    const PreviousMoves previousMoves;
+    const bool quiescence;
+    const bool evasions;
+    const bool quietChecks;
+
+    std::vector<Move>& moves;
+    std::array<int32_t, MAX_MOVES> scores;
+    std::size_t current = 0;
+    std::size_t badCapturesEnd = 0; ///< Losing captures are moved to the front of the buffer, ending at this index
+    std::size_t badCaptureIndex = 0;
+    uint8_t killerIndex = 0;
+    bool skipQuietMoves = false;
+    MovePickerStage stage = MovePickerStage::TT_MOVE;
+};
+
+#endif // MOVE_PICKER_H
\ No newline at end of file
@@ -0,0 +1,106 @@
+#ifndef NNUE_H
+#define NNUE_H
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include "chess_types.h"
+
+struct NNUEAccumulator;
+
+/**
+ * Efficiently updatable neural network evaluation
+ * The network has a simple 768 -> HIDDEN_SIZE x 2 -> 1 architecture. Each of the 768 inputs represents a
+ * piece of a given colour and type on a square, seen from the perspective of one side.
+ * The first layer output (the accumulator) is stored in the board and updated incrementally as pieces are
+ * added and removed so that only the output layer needs to be computed per evaluation
+ */
+class NNUE {
+public:
+    using Piece = Chess::PieceType;
+    using Colour = Chess::PieceColour;
+
+    static constexpr std::size_t INPUT_SIZE = 768;
+    static constexpr std::size_t HIDDEN_SIZE = 256;
+    static constexpr int32_t QA = 255; ///< Quantisation of the first layer and activation clipping value
+    static constexpr int32_t QB = 64; ///< Quantisation of the output layer weights
+    static constexpr int32_t OUTPUT_SCALE = 400; ///< Scales the network output to centipawns
+
+    /**
+     * @brief Loads network weights from a file
+     * @param path Path to the network file
+     * @return True if the network was loaded successfully, otherwise false
+     * @note The file must contain exactly the little endian int16 feature weights [768][HIDDEN_SIZE], feature biases
+     * [HIDDEN_SIZE], output weights [2 * HIDDEN_SIZE] and output bias in that order
+     * @attention The previously loaded network is kept if loading fails
+     * @note Clears the evaluation caches of the calling thread when a network is loaded
+     */
+    static bool load(const std::string& path);
+
+    /**
+     * @brief Checks whether a network has been loaded
+     * @return True if a network is loaded, otherwise false
+     */
+    static inline bool isLoaded() {
+        return networkId != 0;
+    }
+
+    /**
+     * @brief Gets an identifier of the currently loaded network
+     * @return Identifier of the loaded network which changes whenever a new network is loaded, 0 if none is loaded
+     */
+    static inline uint32_t getNetworkId() {
+        return networkId;
+    }
+
+    /**
+     * @brief Sets the accumulator to the feature biases, representing an empty board
+     * @param accumulator Accumulator to reset
+     */
+    static void resetAccumulator(NNUEAccumulator& accumulator);
+
+    /**
+     * @brief Adds a piece to the accumulator from both perspectives
+     * @param accumulator Accumulator to update
+     * @param piece Type of piece
+     * @param colour Colour of piece
+     * @param square Square of piece (0-63)
+     */
+    static void addFeature(NNUEAccumulator& accumulator, Piece piece, Colour colour, uint8_t square);
+
+    /**
+     * @brief Removes a piece from the accumulator from both perspectives
+     * @param accumulator Accumulator to update
+     * @param piece Type of piece
+     * @param colour Colour of piece
+     * @param square Square of piece (0-63)
+     */
+    static void removeFeature(NNUEAccumulator& accumulator, Piece piece, Colour colour, uint8_t square);
+
+    /**
+     * @brief Evaluates a position from its accumulator
+     * @param accumulator Up to date accumulator of the position
+     * @param colour Colour of player to move
+     * @return Evaluation in centipawns from the perspective of the player to move
+     * @warning A network must be loaded before calling this function
+     */
+    static int32_t evaluate(const NNUEAccumulator& accumulator, Colour colour);
+
+    /**
+     * @brief Gets the name of the SIMD kernels that the network runs on
+     * @return "AVX2", "SSE4.1" or "Scalar"
+     */
+    static const char* getKernelName();
+
+private:
+    inline static uint32_t networkId = 0;
+};
+
+/**
+ * First layer output of the network from the perspective of both colours
+ */
+struct NNUEAccumulator {
+    alignas(32) int16_t values[2][NNUE::HIDDEN_SIZE]; ///< Indexed as [colour]
+};
+
+#endif // NNUE_H
\ No newline at end of file
@@ -0,0 +1,74 @@
+#ifndef PAWN_HASH_TABLE_H
+#define PAWN_HASH_TABLE_H
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include "engine/score.h"
+#include "chess_types.h"
+
+/**
+ * Cached pawn structure evaluation for a single pawn hash
+ * Only terms that depend solely on the pawns of both colours are stored
+ */
+struct PawnHashEntry {
+    uint64_t pawnKey;
+    Chess::Bitboard passedPawns[2]; ///< Indexed as [colour]
+    Chess::Bitboard backwardPawnCandidates[2]; ///< Pawns which are backward if the square in front of them is empty, indexed as [colour]
+    Score scores[2]; ///< Doubled, isolated, pawn chain and passed pawn terms, indexed as [colour]
+    bool occupied;
+};
+
+class PawnHashTable {
+public:
+    /**
+     * @brief Creates a pawn hash table
+     * @param size Size of pawn hash table in MB
+     * @note The size of the pawn hash table may be less than the specified number due to rounding for optimisation
+     */
+    PawnHashTable(std::size_t size);
+
+    /**
+     * @brief Adds an entry to the table, always replacing the entry previously stored in its place
+     * @param key Pawn hash of the entry
+     * @param entry Table entry
+     * @return Reference to the stored entry
+     */
+    PawnHashEntry& add(uint64_t key, const PawnHashEntry& entry);
+
+    /**
+     * @brief Gets the entry from the table
+     * @param key Pawn hash of the entry
+     * @return Pointer to the entry if an entry exists for the key, otherwise returns nullptr
+     */
+    PawnHashEntry* getEntry(uint64_t key);
+
+    /**
+     * @brief Clears all table entries and resets the hit counters
+     */
+    void clear();
+
+    /**
+     * @brief Gets the number of getEntry calls since the last clear
+     * @return Number of probes
+     */
+    inline uint64_t getProbes() const {
+        return probes;
+    }
+
+    /**
+     * @brief Gets the number of getEntry calls which found an entry since the last clear
+     * @return Number of hits
+     */
+    inline uint64_t getHits() const {
+        return hits;
+    }
+
+private:
+    const std::size_t TABLE_SIZE;
+    std::vector<PawnHashEntry> table;
+    uint64_t probes = 0;
+    uint64_t hits = 0;
+};
+
+#endif // PAWN_HASH_TABLE_H
\ No newline at end of file
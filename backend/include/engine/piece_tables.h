@@ -2,6 +2,8 @@
 #define PIECE_TABLES_H
 
 #include <cstdint>
+#include <array>
+#include "engine/score.h"
 
 namespace PieceTables {
         inline constexpr int16_t pawns[64] = {
@@ -115,6 +117,32 @@ namespace PieceTables {
 
         inline constexpr const int16_t* tables[6] = {pawns, knights, bishops, rooks, queens, kings};
         inline constexpr const int16_t* endgameTables[6] = {pawnsEnd, knights, bishops, rooks, queens, kingsEnd};
+
+		/// Material value of each piece, indexed as [piece]
+		inline constexpr int16_t pieceValues[6] = {100, 320, 330, 500, 900, 10000};
+
+		/// Contribution of each piece to the game phase (24 = early game, 0 = end game), indexed as [piece]
+		inline constexpr int16_t phaseValues[6] = {0, 1, 1, 2, 4, 0};
+
+		/// Early game and end game piece square table values packed together, indexed as [piece][square]
+		inline constexpr std::array<std::array<Score, 64>, 6> packedTables = [] {
+			std::array<std::array<Score, 64>, 6> packed {};
+			for (int piece = 0; piece < 6; piece++) {
+				for (int square = 0; square < 64; square++) {
+					packed[piece][square] = Score(tables[piece][square], endgameTables[piece][square]);
+				}
+			}
+			return packed;
+		}();
+
+		/// Early game and end game passed pawn values packed together, indexed as [square]
+		inline constexpr std::array<Score, 64> packedPassedPawnTable = [] {
+			std::array<Score, 64> packed {};
+			for (int square = 0; square < 64; square++) {
+				packed[square] = Score(passedPawnTables[0][square], passedPawnTables[1][square]);
+			}
+			return packed;
+		}();
 }
 
 #endif // PIECE_TABLES_H
\ No newline at end of file
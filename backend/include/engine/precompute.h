@@ -4,7 +4,6 @@
 #include <cstdint>
 #include <array>
 #include <algorithm>
-#include <cmath>
 
 namespace EnginePrecompute {
     /**
@@ -38,7 +37,7 @@ namespace EnginePrecompute {
      * @brief Stores a mask for each square and colour with set bits indicating squares that are in behind ranks and in adjaceent files
      * Indexed as [colour][square]
      */
-    inline const std::array<std::array<uint64_t, 64>, 2> backwardPawnMaskTable = [] {
+    inline constexpr std::array<std::array<uint64_t, 64>, 2> backwardPawnMaskTable = [] {
         std::array<std::array<uint64_t, 64>, 2> table {};
         
         for (uint8_t colour = 0; colour < 2; colour++) {
@@ -61,7 +60,7 @@ namespace EnginePrecompute {
      * @brief Stores a mask for each square and colour with set bits indicating squares that a pawn on that square defends
      * Indexed as [colour][square]
      */
-    inline const std::array<std::array<uint64_t, 64>, 2> pawnChainMaskTable = [] {
+    inline constexpr std::array<std::array<uint64_t, 64>, 2> pawnChainMaskTable = [] {
         std::array<std::array<uint64_t, 64>, 2> table {};
 
         for (uint8_t colour = 0; colour < 2; colour++) {
@@ -99,7 +98,7 @@ namespace EnginePrecompute {
      * @attention For king squares not on the first 2 ranks of its side of the board or squares on central files, the mask stored is 0ULL to represent no (weak) protection
      * Indexed as [colour][king square]
      */
-    inline const std::array<std::array<uint64_t, 64>, 2> majorPawnShieldTable = [] {
+    inline constexpr std::array<std::array<uint64_t, 64>, 2> majorPawnShieldTable = [] {
         std::array<std::array<uint64_t, 64>, 2> table {};
 
         for (uint8_t colour = 0; colour < 2; colour++) {
@@ -129,7 +128,7 @@ namespace EnginePrecompute {
      * @attention For king squares that are not on the first rank of its side of the board or diagonal squares that are in central files, the mask will not include these squares to indicate weaker protection
      * Indexed as [colour][king square]
      */
-    inline const std::array<std::array<uint64_t, 64>, 2> minorPawnShieldTable = [] {
+    inline constexpr std::array<std::array<uint64_t, 64>, 2> minorPawnShieldTable = [] {
         std::array<std::array<uint64_t, 64>, 2> table {};
 
         for (uint8_t colour = 0; colour < 2; colour++) {
@@ -164,7 +163,7 @@ namespace EnginePrecompute {
      * @brief Stores a mask for each square and colour of the squares that are both in ahead ranks and in adjacent files
      * Indexed as [colour][square]
      */
-    inline const std::array<std::array<uint64_t, 64>, 2> passedPawnMaskTable = [] {
+    inline constexpr std::array<std::array<uint64_t, 64>, 2> passedPawnMaskTable = [] {
         std::array<std::array<uint64_t, 64>, 2> table {};
 
         for (uint8_t colour = 0; colour < 2; colour++) {
@@ -173,8 +172,12 @@ namespace EnginePrecompute {
                 uint64_t mask = 0x0101010101010101ULL << file; // Mask of current file
                 mask |= adjacentFileMaskTable[file]; // Add adjacent files
 
-                // Remove current and behind ranks
-                mask &= (colour == 0) ? ~((1ULL << (8 * (rank + 1))) - 1) : (1ULL << (8 * rank)) - 1;
+                // Remove current and behind ranks (no ranks are ahead of the last rank)
+                if (colour == 0) {
+                    mask &= (rank == 7) ? 0ULL : ~((1ULL << (8 * (rank + 1))) - 1);
+                } else {
+                    mask &= (1ULL << (8 * rank)) - 1;
+                }
 
                 table[colour][square] = mask;
             }
@@ -186,7 +189,7 @@ namespace EnginePrecompute {
     /**
      * @brief Stores a mask for each square of the squares in that file
      */
-    inline const std::array<uint64_t, 64> fileTable = [] {
+    inline constexpr std::array<uint64_t, 64> fileTable = [] {
         std::array<uint64_t, 64> table {};
 
         for (uint8_t square = 0; square < 64; square++) {
@@ -204,7 +207,7 @@ namespace EnginePrecompute {
      * @note For 2 squares not on the same file, the mask stored is 0ULL
      * Indexed as [square1][square2]
      */
-    inline const std::array<std::array<uint64_t, 64>, 64> sameFileSquaresBetweenTable = [] {
+    inline constexpr std::array<std::array<uint64_t, 64>, 64> sameFileSquaresBetweenTable = [] {
         std::array<std::array<uint64_t, 64>, 64> table {};
 
         for (uint8_t i = 0; i < 64; i++) {
@@ -234,7 +237,7 @@ namespace EnginePrecompute {
      * @note For 2 squares not on the same rank, the mask stored is 0ULL
      * Indexed as [square1][square2]
      */
-    inline const std::array<std::array<uint64_t, 64>, 64> sameRankSquaresBetweenTable = [] {
+    inline constexpr std::array<std::array<uint64_t, 64>, 64> sameRankSquaresBetweenTable = [] {
         std::array<std::array<uint64_t, 64>, 64> table {};
 
         for (uint8_t i = 0; i < 64; i++) {
@@ -263,7 +266,7 @@ namespace EnginePrecompute {
      * @brief Given 2 squares, stores the chebyshev distance between those 2 squares
      * Indexed as [square1][square2]
      */
-    inline const std::array<std::array<uint8_t, 64>, 64> chebyshevDistanceTable = [] {
+    inline constexpr std::array<std::array<uint8_t, 64>, 64> chebyshevDistanceTable = [] {
         std::array<std::array<uint8_t, 64>, 64> table {};
 
         for (uint8_t i = 0; i < 64; i++) {
@@ -272,8 +275,8 @@ namespace EnginePrecompute {
                 int jRank = j / 8, jFile = j % 8;
 
                 // Chebyshev distance (maximum of horizontal and vertical distances)
-                uint8_t rankDifference = static_cast<uint8_t>(std::abs(iRank - jRank));
-                uint8_t fileDifference = static_cast<uint8_t>(std::abs(iFile - jFile));
+                uint8_t rankDifference = static_cast<uint8_t>((iRank > jRank) ? iRank - jRank : jRank - iRank);
+                uint8_t fileDifference = static_cast<uint8_t>((iFile > jFile) ? iFile - jFile : jFile - iFile);
                 table[i][j] = std::max(rankDifference, fileDifference);
             }
         }
@@ -0,0 +1,68 @@
+#ifndef SCORE_H
+#define SCORE_H
+
+#include <cstdint>
+
+/**
+ * Early game and end game evaluation packed into a single 32 bit integer
+ * The end game value is stored in the upper 16 bits and the early game value in the lower 16 bits
+ * so that both halves are added, subtracted and scaled with a single integer operation
+ * @attention Each half must stay within the range of an int16_t
+ */
+struct Score {
+    int32_t value = 0;
+
+    constexpr Score() = default;
+
+    /**
+     * @brief Creates a packed score
+     * @param midgame Early game value
+     * @param endgame End game value
+     */
+    constexpr Score(int16_t midgame, int16_t endgame) :
+        value(static_cast<int32_t>(static_cast<uint32_t>(endgame) << 16) + midgame) {}
+
+    /**
+     * @brief Gets the early game value
+     * @return Early game value
+     */
+    constexpr int16_t midgame() const {
+        return static_cast<int16_t>(static_cast<uint16_t>(static_cast<uint32_t>(value)));
+    }
+
+    /**
+     * @brief Gets the end game value
+     * @return End game value
+     */
+    constexpr int16_t endgame() const {
+        // Rounds up to account for the borrow from a negative early game value
+        return static_cast<int16_t>(static_cast<uint16_t>((static_cast<uint32_t>(value) + 0x8000) >> 16));
+    }
+
+    /**
+     * @brief Interpolates between the early game and end game values
+     * @param phase Current game phase where maxPhase = early game, 0 = end game
+     * @param maxPhase Phase of the early game
+     * @return Tapered evaluation
+     */
+    constexpr int32_t interpolate(int32_t phase, int32_t maxPhase) const {
+        return (midgame() * phase + endgame() * (maxPhase - phase)) / maxPhase;
+    }
+
+    constexpr Score operator+(Score other) const { return fromValue(value + other.value); }
+    constexpr Score operator-(Score other) const { return fromValue(value - other.value); }
+    constexpr Score operator-() const { return fromValue(-value); }
+    constexpr Score operator*(int32_t scale) const { return fromValue(value * scale); }
+    constexpr Score& operator+=(Score other) { value += other.value; return *this; }
+    constexpr Score& operator-=(Score other) { value -= other.value; return *this; }
+    constexpr bool operator==(const Score& other) const = default;
+
+private:
+    static constexpr Score fromValue(int32_t value) {
+        Score score;
+        score.value = value;
+        return score;
+    }
+};
+
+#endif // SCORE_H
\ No newline at end of file
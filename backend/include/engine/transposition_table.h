@@ -15,7 +15,7 @@ enum class TTFlag : uint8_t {
 struct TTEntry {
     uint64_t zobristKey;
     int16_t eval;
-    uint8_t depth;
+    int8_t depth; ///< Remaining depth of a negamax search, or 0 and below for a quiescence search
     int16_t generation;
     TTFlag flag;
     Move bestMove;
@@ -39,7 +39,9 @@ public:
      * @brief Adds an entry to the table
      * @param key Key for table entry
      * @param entry Table entry
-     * @note The entry may not be added if another entry occupies its place
+     * @note Updates the entry of the same key if there is one, unless the new entry is a much shallower bound of the same generation,
+     *       otherwise replaces a stale or the shallowest entry of its bucket
+     * @note A new entry without a best move keeps the best move of the entry of the same key
      */
     void add(uint64_t key, const TTEntry& entry);
 
@@ -50,6 +52,14 @@ public:
      */
     TTEntry* getEntry(uint64_t key);
 
+    /**
+     * @brief Gets the best move of an entry from any generation, as earlier searches still order moves well
+     * @param key Key for table entry
+     * @return Best move of the entry if an entry exists at the key, otherwise Move()
+     * @note Unlike getEntry, entries of previous generations are returned, so the move must only be used for move ordering
+     */
+    Move getBestMove(uint64_t key) const;
+
     /**
      * @brief Clears all table entries
      */
@@ -71,9 +81,11 @@ public:
     }
 
 private:
+    static constexpr int SAME_KEY_DEPTH_MARGIN = 2; // Entries of a stored key at most this much shallower still replace it
+
     const std::size_t TT_SIZE;
     std::vector<TTBucket> table;
-    int16_t currentGeneration;
+    int16_t currentGeneration = 0;
 };
 
 #endif // TRANSPOSITION_TABLE_H
\ No newline at end of file
@@ -50,6 +50,30 @@ public:
         return gameStateHistory.top().hash;
     }
 
+    /**
+     * @brief Gets the zobrist hash of the current pawn structure
+     * @return Zobrist hash of the pawns of both colours
+     */
+    inline uint64_t getPawnHash() {
+        return gameStateHistory.top().pawnHash;
+    }
+
+    /**
+     * @brief Gets the number of half moves elapsed since the last pawn move or capture
+     * @return Half move clock of the current position
+     */
+    inline uint8_t getHalfMoveClock() {
+        return gameStateHistory.top().halfMoveClock;
+    }
+
+    /**
+     * @brief Gets the full move number of the current position
+     * @return Number of moves elapsed since the start of the game starting at 1
+     */
+    inline uint16_t getFullMoves() {
+        return gameStateHistory.top().fullMoves;
+    }
+
     /**
      * @brief Gets the colour that occupies a square
      * @param square Square to get the colour for
@@ -141,13 +165,13 @@ public:
      */
     void undoNullMove();
 
-    // // TESTING PURPOSES ONLY
-    // /**
-    //  * @brief Sets the game state to a given state
-    //  * @param fen FEN string representation of board state
-    //  * @attention This function should only be used for testing and debugging
-    //  */
-    // void setCustomGameState(const char* fen);
+    /**
+     * @brief Sets the game state to a given state
+     * @param fen FEN string representation of board state
+     * @attention This function should only be used for testing, debugging and benchmarking
+     * @note Move history is cleared so the game cannot be undone past this position
+     */
+    void setCustomGameState(const char* fen);
 
 private:
     Board board;
@@ -186,19 +210,19 @@ private:
      */
     bool isIrreversibleMove(Piece piece, Move move);
 
-    inline static std::vector<Move> moveBuffer = [] {
+    inline static thread_local std::vector<Move> moveBuffer = [] {
         std::vector<Move> v;
         v.reserve(256);
         return v;
     }();
 
-    inline static std::vector<uint64_t> positionHistory = [] {
+    inline static thread_local std::vector<uint64_t> positionHistory = [] {
         std::vector<uint64_t> v;
         v.reserve(400);
         return v;
     }();
 
-    inline static std::vector<uint16_t> irreversiblePositionIndices = [] {
+    inline static thread_local std::vector<uint16_t> irreversiblePositionIndices = [] {
         std::vector<uint16_t> v;
         v.reserve(150);
         return v;
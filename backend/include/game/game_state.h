@@ -21,11 +21,12 @@ struct GameState {
     uint16_t fullMoves; ///< Number of moves elapsed since the start of the game starting at 1 and incremented after black's move
 
     uint64_t hash; ///< Zobrist hash of current board state
+    uint64_t pawnHash; ///< Zobrist hash of the pawns of both colours
 };
 
 inline GameState createGameState(Chess::PieceColour playerTurn, std::optional<uint8_t> enPassantSquare, 
                                 const std::array<std::array<bool, 2>, 2>& castleRights, uint8_t halfMoveClock, 
-                                uint16_t fullMoves, uint64_t hash) {
+                                uint16_t fullMoves, uint64_t hash, uint64_t pawnHash) {
 
     return {
         .playerTurn = playerTurn,
@@ -33,7 +34,8 @@ inline GameState createGameState(Chess::PieceColour playerTurn, std::optional<ui
         .castleRights = castleRights,
         .halfMoveClock = halfMoveClock,
         .fullMoves = fullMoves,
-        .hash = hash
+        .hash = hash,
+        .pawnHash = pawnHash
     };
 }
 
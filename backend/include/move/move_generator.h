@@ -99,6 +99,16 @@ public:
      */
     static void pseudoLegalCaptures(const Board& board, Colour colour, std::vector<Move>& moves);
 
+    /**
+     * @brief Adds all pseudo legal moves which are not captures (including castling and promotions) to the given vector moves
+     * @param board Board object representing the current board state
+     * @param colour Colour of piece
+     * @param moves Vector to append legal moves to
+     * @warning This function does not take into account moves where the king will be placed in a check
+     * The vector moves may still append with moves where the king will be in direct danger
+     */
+    static void pseudoLegalQuiets(const Board& board, Colour colour, std::vector<Move>& moves);
+
     /**
      * @brief Adds pseudo legal capture moves to the given vector moves
      * @param board Board object representing the current board state
@@ -135,6 +145,38 @@ public:
      */
     static void pseudoLegalNonCaptureChecks(const Board& board, Colour colour, uint8_t opponentKingSquare, std::vector<Move>& moves);
 
+    /**
+     * @brief Adds the pseudo legal moves which may get the king out of check to the given vector moves
+     * @param board Board object representing the current board state
+     * @param colour Colour of the player in check
+     * @param moves Vector to append legal moves to
+     * @warning This function does not take into account moves where the king will be placed in a check
+     * The vector moves may still append with king moves onto attacked squares and moves of pinned pieces
+     * @attention The king of the given colour must be in check
+     * @note Only king moves are added in double check, otherwise moves of other pieces must capture the checker or block the check
+     */
+    static void pseudoLegalEvasions(const Board& board, Colour colour, std::vector<Move>& moves);
+
+    /**
+     * @brief Checks if a move would be generated by pseudoLegalMoves without generating any moves
+     * @param board Board object representing the current board state
+     * @param colour Colour of player making the move
+     * @param move Move to check, for example from the transposition table or killer move table
+     * @return True if the move is pseudo legal in the current position, otherwise false
+     * @note The null move Move() is never pseudo legal
+     */
+    static bool isPseudoLegal(const Board& board, Colour colour, Move move);
+
+    /**
+     * @brief Checks if a pseudo legal move leaves the king of the player making it out of check without making the move
+     * @param board Board object representing the current board state
+     * @param colour Colour of player making the move
+     * @param move Pseudo legal move to check
+     * @return True if the move is legal, otherwise false
+     * @attention The move must be pseudo legal, either generated by this class or accepted by isPseudoLegal
+     */
+    static bool isLegal(const Board& board, Colour colour, Move move);
+
 private:
     /**
      * @brief Filters out illegal moves
@@ -156,6 +198,25 @@ private:
      */
     static void pseudoLegalPawnMoves(const Board& board, Colour colour, uint8_t currSquare, std::vector<Move>& moves);
 
+    /**
+     * @brief Adds pseudo legal pawn moves which are not captures (single and double pushes and push promotions) to the given vector moves
+     * @param board Board object representing the current board state
+     * @param colour Colour of piece
+     * @param currSquare Square that the pawn is located on (0-63)
+     * @param moves Vector to append legal moves to
+     */
+    static void pseudoLegalPawnPushes(const Board& board, Colour colour, uint8_t currSquare, std::vector<Move>& moves);
+
+    /**
+     * @brief Adds pseudo legal castling moves to the given vector moves
+     * @param board Board object representing the current board state
+     * @param colour Colour of king
+     * @param currSquare Square that the king is located on (0-63)
+     * @param moves Vector to append legal moves to
+     * @note Castling through or out of check is not generated
+     */
+    static void pseudoLegalCastlingMoves(const Board& board, Colour colour, uint8_t currSquare, std::vector<Move>& moves);
+
     /// \copydoc MoveGenerator::pseudoLegalPawnMoves
     static void pseudoLegalKnightMoves(const Board& board, Colour colour, uint8_t currSquare, std::vector<Move>& moves);
 
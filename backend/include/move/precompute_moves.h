@@ -7,8 +7,10 @@
 #include <vector>
 #include <bit>
 #include <optional>
+#include <initializer_list>
 #include "board/board.h"
 #include "move/move.h"
+#include "move/slider_tables.h"
 #include "chess_types.h"
 
 namespace {
@@ -137,91 +139,6 @@ namespace {
         return table;
     }
 
-    /**
-     * @brief Generates a bitboard of rook moves including the final squares in each ray
-     * @param square Square that the rook occupies
-     * @param blockerBitboard Bitboard of blocking pieces in rays
-     * @return Bitboard of rook moves
-     */
-    Bitboard generateRookMoves(const uint8_t square, const Bitboard blockerBitboard) {
-        using Function = uint8_t(*)(uint8_t);
-
-        constexpr int directions[4] = {-1, 8, 1, -8}; // ←, ↑, →, ↓
-        constexpr uint8_t boundaryChecks[4] = {0, 7, 7, 0}; // file, rank, file, rank
-        Function functions[2] = {Board::getFile, Board::getRank}; // Alternate between file and rank checks
-
-        Bitboard moves = 0ULL;
-        for (int i = 0; i < 4; i++) {
-            // Not at specific edge of the board
-            if (functions[i & 0x1](square) != boundaryChecks[i]) { // toggle between checking file and rank
-                uint8_t newSquare = square + directions[i];
-                // Not at specific edge of the board and square is not occupied
-                while (functions[i & 0x1](newSquare) != boundaryChecks[i] && !(blockerBitboard & (1ULL << newSquare))) {
-                    moves |= (1ULL << newSquare);
-                    newSquare += directions[i];
-                }
-                // Final square is either an empty square on the edge of the board or an occupied square
-                moves |= (1ULL << newSquare);
-            }
-        }
-
-        return moves;
-    }
-
-    /**
-     * @brief Generates a bitboard of bishop moves including the final squares in each ray
-     * @param square Square that the bishop occupies
-     * @param blockerBitboard Bitboard of blocking pieces in rays
-     * @return Bitboard of bishop moves
-     */
-    Bitboard generateBishopMoves(const uint8_t square, const Bitboard blockerBitboard) {
-        constexpr int directions[4] = {7, 9, -9, -7}; // ↖, ↗, ↙, ↘
-        constexpr uint8_t rankChecks[4] = {7, 7, 0, 0}; // Boundaries depending on direction
-        constexpr uint8_t fileChecks[4] = {0, 7, 0, 7}; // Boundaries depending on direction
-
-        Bitboard moves = 0ULL;
-        for (int i = 0; i < 4; i++) {
-            // Not at specific edge of the board
-            if (Board::getFile(square) != fileChecks[i] && Board::getRank(square) != rankChecks[i]) {
-                uint8_t newSquare = square + directions[i];
-                // Not at specific edge of the board and square is not occupied
-                while (Board::getFile(newSquare) != fileChecks[i] && 
-                       Board::getRank(newSquare) != rankChecks[i] && 
-                       !(blockerBitboard & (1ULL << newSquare))) {
-
-                    moves |= (1ULL << newSquare);
-                    newSquare += directions[i];
-                }
-                // Final square is either an empty square on the edge of the board or an occupied square
-                moves |= (1ULL << newSquare);
-            }
-        }
-
-        return moves;
-    }
-
-    /**
-     * @brief Converts a pext number to a blocker bitboard
-     * @param pextIndex Pext number to convert
-     * @param mask Mask of potential moves for sliding piece
-     * @return Blocker bitboard from pext number
-     */
-    Bitboard pextIndexToBlockerBitboard(uint64_t pextIndex, Bitboard mask) {
-        Bitboard blockerBitboard = 0ULL;
-        int pextBitIndex = 0;
-
-        while (mask) {
-            int maskBitIndex = std::countr_zero(mask);
-            uint64_t bit = (pextIndex >> pextBitIndex) & 0x1; // Gets the pextIndexBit of pextIndex
-            blockerBitboard |= (bit << maskBitIndex); // Set the maskBitIndex of blockerBitboard to bit
-
-            pextBitIndex++;
-            mask &= mask - 1;
-        }
-
-        return blockerBitboard;
-    }
-
     /**
      * @brief Converts a bitboard to a pext number
      * @param bitboard Bitboard to convert to pext number
@@ -265,8 +182,8 @@ public:
 
     inline static constexpr std::array<std::array<Bitboard, 64>, 2> pawnThreatTable = [] {
         std::array<std::array<Bitboard, 64>, 2> table {};
-        constexpr std::array<std::array<int, 2>, 8> whiteOffsets = {{{-1, -1}, {1, -1}}};
-        constexpr std::array<std::array<int, 2>, 8> blackOffsets = {{{-1, 1}, {1, 1}}};
+        constexpr std::array<std::array<int, 2>, 2> whiteOffsets = {{{-1, -1}, {1, -1}}};
+        constexpr std::array<std::array<int, 2>, 2> blackOffsets = {{{-1, 1}, {1, 1}}};
 
         table[0] = generateMoveTable(whiteOffsets);
         table[1] = generateMoveTable(blackOffsets);
@@ -276,8 +193,8 @@ public:
 
     inline static constexpr std::array<std::array<Bitboard, 64>, 2> pawnCaptureTable = [] {
         std::array<std::array<Bitboard, 64>, 2> table {};
-        constexpr std::array<std::array<int, 2>, 8> whiteOffsets = {{{-1, 1}, {1, 1}}};
-        constexpr std::array<std::array<int, 2>, 8> blackOffsets = {{{-1, -1}, {1, -1}}};
+        constexpr std::array<std::array<int, 2>, 2> whiteOffsets = {{{-1, 1}, {1, 1}}};
+        constexpr std::array<std::array<int, 2>, 2> blackOffsets = {{{-1, -1}, {1, -1}}};
 
         table[0] = generateMoveTable(whiteOffsets);
         table[1] = generateMoveTable(blackOffsets);
@@ -370,6 +287,61 @@ public:
         return table;
     }();
 
+    /// Squares strictly between two squares sharing a rank, file or diagonal, 0 if they are not aligned, indexed as [square][square]
+    inline static constexpr std::array<std::array<Bitboard, 64>, 64> squaresBetweenTable = [] {
+        std::array<std::array<Bitboard, 64>, 64> table {};
+        for (int from = 0; from < 64; from++) {
+            for (int to = 0; to < 64; to++) {
+                int fileDifference = to % 8 - from % 8;
+                int rankDifference = to / 8 - from / 8;
+                bool aligned = (fileDifference == 0 || rankDifference == 0 ||
+                                fileDifference == rankDifference || fileDifference == -rankDifference);
+                if (from == to || !aligned) continue;
+
+                int fileStep = (fileDifference > 0) - (fileDifference < 0);
+                int rankStep = (rankDifference > 0) - (rankDifference < 0);
+                Bitboard between = 0ULL;
+                for (int square = from + 8 * rankStep + fileStep; square != to; square += 8 * rankStep + fileStep) {
+                    between |= (1ULL << square);
+                }
+                table[from][to] = between;
+            }
+        }
+
+        return table;
+    }();
+
+    /// Every square of the rank, file or diagonal through two squares, 0 if they are not aligned, indexed as [square][square]
+    inline static constexpr std::array<std::array<Bitboard, 64>, 64> lineTable = [] {
+        std::array<std::array<Bitboard, 64>, 64> table {};
+        for (int from = 0; from < 64; from++) {
+            for (int to = 0; to < 64; to++) {
+                int fileDifference = to % 8 - from % 8;
+                int rankDifference = to / 8 - from / 8;
+                bool aligned = (fileDifference == 0 || rankDifference == 0 ||
+                                fileDifference == rankDifference || fileDifference == -rankDifference);
+                if (from == to || !aligned) continue;
+
+                int fileStep = (fileDifference > 0) - (fileDifference < 0);
+                int rankStep = (rankDifference > 0) - (rankDifference < 0);
+                Bitboard line = (1ULL << from);
+                // Walk to the edge of the board in both directions
+                for (int direction : {1, -1}) {
+                    int file = from % 8 + direction * fileStep;
+                    int rank = from / 8 + direction * rankStep;
+                    while (0 <= file && file < 8 && 0 <= rank && rank < 8) {
+                        line |= (1ULL << (8 * rank + file));
+                        file += direction * fileStep;
+                        rank += direction * rankStep;
+                    }
+                }
+                table[from][to] = line;
+            }
+        }
+
+        return table;
+    }();
+
     /**
      * @brief Gets a bitboard of pseudolegal rook moves including the final squares in each ray
      * @param square Square that the rook occupies
@@ -381,7 +353,7 @@ public:
         int pextIndex = bitboardToPextIndex(occupiedBitboard, rookMask);
         int index = rookMoveTableOffsets[square] + pextIndex;
         
-        return rookMoveTable[index];
+        return SliderTables::rookMoveTable[index];
     }
 
     /**
@@ -395,7 +367,7 @@ public:
         int pextIndex = bitboardToPextIndex(occupiedBitboard, bishopMask);
         int index = bishopMoveTableOffsets[square] + pextIndex;
         
-        return bishopMoveTable[index];
+        return SliderTables::bishopMoveTable[index];
     }
 
 private:
@@ -425,43 +397,9 @@ private:
         return table;
     }();
 
-    inline static const std::array<Bitboard, rookMoveTableSize> rookMoveTable = [] {
-        std::array<Bitboard, rookMoveTableSize> table {};
-
-        for (uint8_t square = 0; square < 64; square++) {
-            Bitboard mask = rookMasks[square];
-            int blockerBitboardPermutations = 1 << std::popcount(mask); // 2^n permutations for possible blocker bitboards
-
-            // Loop through each blocker bitboard permutation
-            for (int pextIndex = 0; pextIndex < blockerBitboardPermutations; pextIndex++) {
-                Bitboard blockers = pextIndexToBlockerBitboard(pextIndex, mask);
-                Bitboard moves = generateRookMoves(square, blockers);
-                int index = rookMoveTableOffsets[square] + pextIndex;
-                table[index] = moves;
-            }
-        }
-
-        return table;
-    }();
-
-    inline static const std::array<Bitboard, bishopMoveTableSize> bishopMoveTable = [] {
-        std::array<Bitboard, bishopMoveTableSize> table {};
-
-        for (uint8_t square = 0; square < 64; square++) {
-            Bitboard mask = bishopMasks[square];
-            int blockerBitboardPermutations = 1 << std::popcount(mask); // 2^n permutations for possible blocker bitboards
-
-            // Loop through each blocker bitboard permutation
-            for (int pextIndex = 0; pextIndex < blockerBitboardPermutations; pextIndex++) {
-                Bitboard blockers = pextIndexToBlockerBitboard(pextIndex, mask);
-                Bitboard moves = generateBishopMoves(square, blockers);
-                int index = bishopMoveTableOffsets[square] + pextIndex;
-                table[index] = moves;
-            }
-        }
-
-        return table;
-    }();
+    // The slider move tables are generated by scripts/generate_slider_tables.py and embedded as read-only data
+    static_assert(rookMoveTableSize == SliderTables::ROOK_MOVE_TABLE_SIZE, "Generated rook move table does not match the rook masks");
+    static_assert(bishopMoveTableSize == SliderTables::BISHOP_MOVE_TABLE_SIZE, "Generated bishop move table does not match the bishop masks");
 };
 
 #endif // PRECOMPUTE_MOVES_H
\ No newline at end of file
@@ -0,0 +1,19 @@
+#ifndef SLIDER_TABLES_H
+#define SLIDER_TABLES_H
+
+#include <cstdint>
+#include <cstddef>
+
+// Generated by scripts/generate_slider_tables.py
+namespace SliderTables {
+    inline constexpr std::size_t ROOK_MOVE_TABLE_SIZE = 102400;
+    inline constexpr std::size_t BISHOP_MOVE_TABLE_SIZE = 5248;
+
+    /// Rook moves for every square and blocker permutation, indexed as [rook offset of square + pext index of blockers]
+    extern const uint64_t rookMoveTable[ROOK_MOVE_TABLE_SIZE];
+
+    /// Bishop moves for every square and blocker permutation, indexed as [bishop offset of square + pext index of blockers]
+    extern const uint64_t bishopMoveTable[BISHOP_MOVE_TABLE_SIZE];
+}
+
+#endif // SLIDER_TABLES_H
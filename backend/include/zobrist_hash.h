@@ -47,6 +47,28 @@ namespace Zobrist {
      */
     uint64_t updateNullMoveHash(uint64_t currentHash, const std::optional<uint8_t> oldEnPassantSquare);
 
+    /**
+     * @brief Computes the zobrist hash of the pawn structure
+     * @param board Board object representing current board state
+     * @return Zobrist hash of the pawns of both colours
+     * @note This function should only be used to compute the initial pawn hash
+     * Updates to the pawn hash should be computed more efficiently using updatePawnHash
+     */
+    uint64_t computeInitialPawnHash(const Board& board);
+
+    /**
+     * @brief Updates the zobrist hash of the pawn structure
+     * @param currentPawnHash Pawn hash computed from the previous game state
+     * @param move Move object representing the current move
+     * @param oldEnPassantSquare The updated square of the pawn that just moved 2 forward before the move if it exists
+     * @param playerTurn Turn of player that just made their move
+     * @param movedPiece Piece that was last moved
+     * @return Updated pawn hash of the current game state
+     * @attention currentPawnHash should be first computed once using computeInitialPawnHash
+     */
+    uint64_t updatePawnHash(uint64_t currentPawnHash, const Move move, const std::optional<uint8_t> oldEnPassantSquare,
+                            Chess::PieceColour playerTurn, Chess::PieceType movedPiece);
+
     /**
      * @brief Computes the zobrist hash of the game state
      * @param fen FEN representation of the current game state
@@ -9,6 +9,9 @@
 #include <bit>
 #include "board/board.h"
 #include "move/move.h"
+#include "engine/piece_tables.h"
+#include "engine/nnue.h"
+#include "move/precompute_moves.h"
 #include "chess_types.h"
 
 using Chess::toIndex;
@@ -35,6 +38,16 @@ void Board::addPiece(Piece piece, Colour colour, uint8_t square) {
     piecesBitboard |= mask;
     pieceCache[square] = piece;
     colourCache[square] = colour;
+
+    uint8_t c = toIndex(colour);
+    uint8_t p = toIndex(piece);
+    uint8_t tableSquare = (colour == Colour::WHITE) ? square ^ 0x38 : square; // Flip square from black to white's perspective
+    materialScores[c] += PieceTables::pieceValues[p];
+    pieceSquareScores[c] += PieceTables::packedTables[p][tableSquare];
+    phase += PieceTables::phaseValues[p];
+    attackInfoStack.back().validFlags = 0;
+
+    if (accumulatorNetworkId) NNUE::addFeature(accumulator, piece, colour, square);
 }
 
 void Board::removePiece(Piece piece, Colour colour, uint8_t square) {
@@ -46,6 +59,16 @@ void Board::removePiece(Piece piece, Colour colour, uint8_t square) {
     piecesBitboard &= mask;
     pieceCache[square] = Piece::NONE;
     colourCache[square] = Colour::NONE;
+
+    uint8_t c = toIndex(colour);
+    uint8_t p = toIndex(piece);
+    uint8_t tableSquare = (colour == Colour::WHITE) ? square ^ 0x38 : square; // Flip square from black to white's perspective
+    materialScores[c] -= PieceTables::pieceValues[p];
+    pieceSquareScores[c] -= PieceTables::packedTables[p][tableSquare];
+    phase -= PieceTables::phaseValues[p];
+    attackInfoStack.back().validFlags = 0;
+
+    if (accumulatorNetworkId) NNUE::removeFeature(accumulator, piece, colour, square);
 }
 
 void Board::removePiece(uint8_t square) {
@@ -71,6 +94,7 @@ void Board::makeMove(const Move move, Colour playerTurn) {
     uint8_t fromSquare = move.getFromSquare();
     uint8_t toSquare = move.getToSquare();
     Piece piece = getPiece(fromSquare);
+    attackInfoStack.emplace_back(); // Keep the attack information of the position before the move for when it is undone
 
     // Remove castling rights if rook has moved
     std::array<std::array<uint8_t, 2>, 2> startingRookSquares = {{{7, 0}, {63, 56}}};
@@ -182,6 +206,13 @@ void Board::undo(const Move move, Colour oldPlayerTurn, std::array<std::array<bo
 
     castlingRights = oldCastlingRights; // Restore castling rights
     enPassantSquare = oldEnPassantSquare; // Restore en passant square
+
+    // Pieces were moved back so the attack information of the position before the move is valid again
+    if (attackInfoStack.size() > 1) {
+        attackInfoStack.pop_back();
+    } else {
+        attackInfoStack.back().validFlags = 0;
+    }
 }
 
 void Board::resetBoard() {
@@ -240,6 +271,130 @@ void Board::resetPieces() {
     }
 
     piecesBitboard = whitePiecesBitboard | blackPiecesBitboard;
+    recomputeScores();
+}
+
+void Board::recomputeScores() {
+    materialScores = {0, 0};
+    pieceSquareScores = {Score(), Score()};
+    phase = 0;
+
+    for (uint8_t c = 0; c < 2; c++) {
+        for (uint8_t p = 0; p < 6; p++) {
+            Bitboard bitboard = pieceBitboards[c][p];
+            while (bitboard) {
+                uint8_t square = std::countr_zero(bitboard);
+                uint8_t tableSquare = (c == toIndex(Colour::WHITE)) ? square ^ 0x38 : square; // Flip square from black to white's perspective
+                materialScores[c] += PieceTables::pieceValues[p];
+                pieceSquareScores[c] += PieceTables::packedTables[p][tableSquare];
+                phase += PieceTables::phaseValues[p];
+
+                bitboard &= bitboard - 1;
+            }
+        }
+    }
+
+    attackInfoStack.assign(1, AttackInfo());
+
+    if (accumulatorNetworkId) refreshAccumulator();
+}
+
+Bitboard Board::attackersTo(uint8_t square, Bitboard occupiedBitboard) const {
+    assert(square < 64 && "square must be between 0-63");
+    constexpr uint8_t white = toIndex(Colour::WHITE);
+    constexpr uint8_t black = toIndex(Colour::BLACK);
+
+    Bitboard queensBitboard = pieceBitboards[white][toIndex(Piece::QUEEN)] | pieceBitboards[black][toIndex(Piece::QUEEN)];
+    Bitboard rooksQueensBitboard = pieceBitboards[white][toIndex(Piece::ROOK)] | pieceBitboards[black][toIndex(Piece::ROOK)] | queensBitboard;
+    Bitboard bishopsQueensBitboard = pieceBitboards[white][toIndex(Piece::BISHOP)] | pieceBitboards[black][toIndex(Piece::BISHOP)] | queensBitboard;
+    Bitboard knightsBitboard = pieceBitboards[white][toIndex(Piece::KNIGHT)] | pieceBitboards[black][toIndex(Piece::KNIGHT)];
+    Bitboard kingsBitboard = pieceBitboards[white][toIndex(Piece::KING)] | pieceBitboards[black][toIndex(Piece::KING)];
+
+    Bitboard attackers = (PrecomputeMoves::getRookMovesFromTable(square, occupiedBitboard) & rooksQueensBitboard) |
+                         (PrecomputeMoves::getBishopMovesFromTable(square, occupiedBitboard) & bishopsQueensBitboard) |
+                         (PrecomputeMoves::knightMoveTable[square] & knightsBitboard) |
+                         (PrecomputeMoves::kingMoveTable[square] & kingsBitboard) |
+                         // Squares from which a pawn of each colour attacks the square
+                         (PrecomputeMoves::pawnThreatTable[white][square] & pieceBitboards[white][toIndex(Piece::PAWN)]) |
+                         (PrecomputeMoves::pawnThreatTable[black][square] & pieceBitboards[black][toIndex(Piece::PAWN)]);
+
+    return attackers & occupiedBitboard;
+}
+
+Bitboard Board::computeAttackInfo(uint8_t flag, Colour colour) const {
+    const uint8_t c = toIndex(colour);
+    const uint8_t opposing = c ^ 1;
+
+    if (flag == ATTACKS_CACHED) {
+        Bitboard attacks = 0ULL;
+        const Bitboard queens = pieceBitboards[c][toIndex(Piece::QUEEN)];
+
+        Bitboard rooksQueens = pieceBitboards[c][toIndex(Piece::ROOK)] | queens;
+        while (rooksQueens) {
+            attacks |= PrecomputeMoves::getRookMovesFromTable(std::countr_zero(rooksQueens), piecesBitboard);
+            rooksQueens &= rooksQueens - 1;
+        }
+
+        Bitboard bishopsQueens = pieceBitboards[c][toIndex(Piece::BISHOP)] | queens;
+        while (bishopsQueens) {
+            attacks |= PrecomputeMoves::getBishopMovesFromTable(std::countr_zero(bishopsQueens), piecesBitboard);
+            bishopsQueens &= bishopsQueens - 1;
+        }
+
+        Bitboard knights = pieceBitboards[c][toIndex(Piece::KNIGHT)];
+        while (knights) {
+            attacks |= PrecomputeMoves::knightMoveTable[std::countr_zero(knights)];
+            knights &= knights - 1;
+        }
+
+        Bitboard pawns = pieceBitboards[c][toIndex(Piece::PAWN)];
+        while (pawns) {
+            attacks |= PrecomputeMoves::pawnCaptureTable[c][std::countr_zero(pawns)];
+            pawns &= pawns - 1;
+        }
+
+        Bitboard king = pieceBitboards[c][toIndex(Piece::KING)];
+        if (king) attacks |= PrecomputeMoves::kingMoveTable[std::countr_zero(king)];
+
+        return attacks;
+    }
+
+    if (!pieceBitboards[c][toIndex(Piece::KING)]) return 0ULL;
+    const uint8_t kingSquare = getKingSquare(colour);
+    const Bitboard opposingBitboard = (colour == Colour::WHITE) ? blackPiecesBitboard : whitePiecesBitboard;
+    if (flag == CHECKERS_CACHED) return attackersTo(kingSquare) & opposingBitboard;
+
+    // Opposing sliders which would attack the king on an empty board pin a piece if it is the only one between them
+    const Bitboard opposingQueens = pieceBitboards[opposing][toIndex(Piece::QUEEN)];
+    Bitboard snipers = (PrecomputeMoves::getRookMovesFromTable(kingSquare, 0ULL) & (pieceBitboards[opposing][toIndex(Piece::ROOK)] | opposingQueens)) |
+                       (PrecomputeMoves::getBishopMovesFromTable(kingSquare, 0ULL) & (pieceBitboards[opposing][toIndex(Piece::BISHOP)] | opposingQueens));
+
+    const Bitboard ownBitboard = (colour == Colour::WHITE) ? whitePiecesBitboard : blackPiecesBitboard;
+    Bitboard pinnedBitboard = 0ULL;
+    while (snipers) {
+        Bitboard between = PrecomputeMoves::squaresBetweenTable[kingSquare][std::countr_zero(snipers)] & piecesBitboard;
+        if (between && !(between & (between - 1))) pinnedBitboard |= between & ownBitboard;
+        snipers &= snipers - 1;
+    }
+
+    return pinnedBitboard;
+}
+
+void Board::refreshAccumulator() {
+    accumulatorNetworkId = NNUE::getNetworkId();
+    if (!accumulatorNetworkId) return;
+
+    NNUE::resetAccumulator(accumulator);
+    for (uint8_t c = 0; c < 2; c++) {
+        for (uint8_t p = 0; p < 6; p++) {
+            Bitboard bitboard = pieceBitboards[c][p];
+            while (bitboard) {
+                uint8_t square = std::countr_zero(bitboard);
+                NNUE::addFeature(accumulator, fromIndex<Piece>(p), fromIndex<Colour>(c), square);
+                bitboard &= bitboard - 1;
+            }
+        }
+    }
 }
 
 // TESTING PURPOSES ONLY
@@ -336,6 +491,7 @@ void Board::setCustomBoardState(const char* fen) {
         index++;
     }
     piecesBitboard = whitePiecesBitboard | blackPiecesBitboard;
+    recomputeScores();
 
     index += 3; // Jump to castling rights
     castlingRights[toIndex(Colour::WHITE)][toIndex(Castling::KINGSIDE)] = false;
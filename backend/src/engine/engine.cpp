@@ -1,18 +1,21 @@
 #include <vector>
+#include <array>
 #include <cstdint>
+#include <cstddef>
 #include <cmath>
 #include <limits>
 #include <algorithm>
 #include <functional>
 #include <bit>
 #include <chrono>
+#include <optional>
 #include "engine/engine.h"
 #include "engine/transposition_table.h"
 #include "engine/evaluation.h"
+#include "engine/move_picker.h"
 #include "board/board.h"
 #include "move/move.h"
 #include "game/game.h"
-#include "check/check.h"
 #include "move/move_generator.h"
 #include "book/opening_book.h"
 #include "chess_types.h"
@@ -23,6 +26,20 @@ using Chess::Bitboard;
 using Chess::toIndex;
 
 namespace {
+    constexpr int LMR_TABLE_SIZE = 64;
+
+    /// Base late move reduction indexed as [depth][moveCount], both clamped to the size of the table
+    const auto lateMoveReductionTable = [] {
+        std::array<std::array<int8_t, LMR_TABLE_SIZE>, LMR_TABLE_SIZE> table {};
+        for (int depth = 1; depth < LMR_TABLE_SIZE; depth++) {
+            for (int moveCount = 1; moveCount < LMR_TABLE_SIZE; moveCount++) {
+                table[depth][moveCount] = static_cast<int8_t>(0.33 + std::log(depth) * std::log(moveCount) / 2.25);
+            }
+        }
+
+        return table;
+    }();
+
     bool notZugzwangNullMovePruningCheck(Board& board, Colour colour) {
         Bitboard bitboard = board.getBitboard(Piece::KNIGHT, colour) |
                             board.getBitboard(Piece::BISHOP, colour) |
@@ -33,14 +50,16 @@ namespace {
     }
 }
 
-Engine::Engine(int timeLimit, uint8_t maxDepth, uint8_t quiescenceDepth) : 
+Engine::Engine(int timeLimit, uint8_t maxDepth, uint8_t quiescenceDepth, std::size_t transpositionTableSize) : 
     TIME_LIMIT(timeLimit),
     MAX_DEPTH(maxDepth),
     QUIESCENCE_DEPTH(quiescenceDepth),
-    transpositionTable(256),
-    quiescenceTranspositionTable(256),
+    transpositionTable(transpositionTableSize),
     negamaxMoveBuffers(maxDepth + MAX_EXTENSION_COUNT + 1),
-    quiescenceMoveBuffers(quiescenceDepth + 1) {
+    quiescenceMoveBuffers(quiescenceDepth + 1),
+    staticEvals(maxDepth + MAX_EXTENSION_COUNT + 1, NO_STATIC_EVAL),
+    excludedMoves(maxDepth + MAX_EXTENSION_COUNT + 1),
+    playedMoves(maxDepth + MAX_EXTENSION_COUNT + 1) {
 
         moveBuffer.reserve(256);
         for (auto& buffer : negamaxMoveBuffers) buffer.reserve(256);
@@ -52,10 +71,13 @@ Move Engine::getMove(Game& game) {
     Colour colour = game.getCurrentTurn();
     Move bestMove;
     maxDepthSearched = 0;
+    stats = SearchStats();
 
     auto start = std::chrono::steady_clock::now();
 
     auto timeUp = [&]() {
+        if (nodeLimit && stats.nodes + stats.quiescenceNodes >= nodeLimit) return true;
+
         auto now = std::chrono::steady_clock::now();
         return std::chrono::duration_cast<std::chrono::milliseconds>(now - start).count() >= TIME_LIMIT;
     };
@@ -77,19 +99,16 @@ Move Engine::getMove(Game& game) {
         
         int moveCount = 0;
         for (const Move move : moveBuffer) {
-            game.makeMove(move);
-            bool inCheck = Check::isInCheck(board, colour);
-
             // Illegal move
-            if (inCheck) {
-                game.undo();
-                continue;
-            }
+            if (!MoveGenerator::isLegal(board, colour, move)) continue;
+
+            playedMoves[0] = {board.getPiece(move.getFromSquare()), move.getToSquare()};
+            game.makeMove(move);
 
             GameStateEvaluation newState = game.getCurrentGameStateEvaluation();
             bool isPVNode = (moveCount == 0);
             bool allowNullMove = !isPVNode;
-            int16_t eval = -negamax(game, depth - 1, -beta, -alpha, newState, isPVNode, timeUp, 1, 0, allowNullMove);
+            int16_t eval = -negamax(game, depth - 1, -beta, -alpha, newState, isPVNode, false, timeUp, 1, 0, allowNullMove);
             game.undo();
             moveCount++;
 
@@ -111,7 +130,6 @@ Move Engine::getMove(Game& game) {
     Evaluation::clearKillerMoveTable();
     Evaluation::ageHistoryHeuristicsTable();
     transpositionTable.incrementGeneration();
-    quiescenceTranspositionTable.incrementGeneration();
     previousMove = bestMove;
 
     Move bookMove = OpeningBook::getMove(game.getHash(), board);
@@ -123,12 +141,22 @@ Move Engine::getMove(Game& game) {
     return bestMove;
 }
 
-int16_t Engine::negamax(Game& game, int depth, int16_t alpha, int16_t beta, GameStateEvaluation state, bool isPVNode,
+std::optional<TTEntry> Engine::probeTranspositionTable(uint64_t hash) {
+    TTEntry* entry = transpositionTable.getEntry(hash);
+    return entry ? std::optional<TTEntry>(*entry) : std::nullopt;
+}
+
+int16_t Engine::negamax(Game& game, int depth, int16_t alpha, int16_t beta, GameStateEvaluation state, bool isPVNode, bool cutNode,
                         const std::function<bool()>& timeUp, uint8_t ply, int extensionCount, bool allowNullMove) {
 
+    stats.nodes++;
     uint64_t hash = game.getHash();
-    TTEntry* entry = transpositionTable.getEntry(hash);
-    if (entry && entry->depth >= depth) {
+    // Copied as the recursive searches of this node may replace the slot of the entry with another position
+    std::optional<TTEntry> entry = probeTranspositionTable(hash);
+    // The entry of a singular extension search node belongs to the search with every move
+    // A node with no depth remaining is a full quiescence search, so it needs an entry of at least its first ply
+    const Move excludedMove = excludedMoves[ply];
+    if (entry && entry->depth >= std::max(depth, 0) && excludedMove == Move()) {
         if (entry->flag == TTFlag::EXACT ||
            (entry->flag == TTFlag::LOWER_BOUND && entry->eval >= beta) ||
            (entry->flag == TTFlag::UPPER_BOUND && entry->eval <= alpha)) {
@@ -145,53 +173,189 @@ int16_t Engine::negamax(Game& game, int depth, int16_t alpha, int16_t beta, Game
 
     if (depth <= 0) return quiescence(game, alpha, beta, QUIESCENCE_DEPTH, state, ply);
 
+    // The move is used for ordering so an entry of any depth or generation is good enough
+    Move ttMove = transpositionTable.getBestMove(hash);
+
+    // PV and expected cut nodes without a transposition table move are the worst ordered, so they are searched one ply shallower
+    // Every move of an expected all node is searched anyway, so its ordering matters little
+    const bool zeroWindow = (beta - alpha == 1);
+    if (internalIterativeMode == InternalIterativeMode::REDUCTION && ttMove == Move() && excludedMove == Move() &&
+        depth >= INTERNAL_ITERATIVE_MIN_DEPTH && (!zeroWindow || cutNode)) {
+        depth--;
+    }
+
     Board& board = game.getBoard();
     Colour colour = game.getCurrentTurn();
+    Colour opposingColour = (colour == Colour::WHITE) ? Colour::BLACK : Colour::WHITE;
+    const bool inCheck = (state == GameStateEvaluation::CHECK);
+
+    // Shared by null move pruning and the forward pruning below, none of which are done in check
+    // The raw evaluation is kept to measure its error once the search completes
+    const int16_t rawStaticEval = inCheck ? 0 : Evaluation::evaluate(game, state, ply);
+    const int16_t staticEval = inCheck ? 0 : Evaluation::correctStaticEval(rawStaticEval, colour, game.getPawnHash());
+    staticEvals[ply] = inCheck ? NO_STATIC_EVAL : staticEval;
+
+    // Improving if the static evaluation has risen since the last move of this player, assumed when it cannot be compared
+    const bool improving = !inCheck && (ply < 3 || staticEvals[ply - 2] == NO_STATIC_EVAL || staticEval > staticEvals[ply - 2]);
+
+    // The window is used rather than isPVNode as the first move of every node is searched with isPVNode set
+    const bool canPrune = !inCheck && zeroWindow && !Evaluation::isMateScore(alpha) && !Evaluation::isMateScore(beta);
+
+    // Reverse futility pruning, not done in a singular extension search as it cannot take the excluded move into account
+    if (canPrune && excludedMove == Move() && pruning.reverseFutilityPruning && depth <= pruning.reverseFutilityMaxDepth &&
+        staticEval - pruning.reverseFutilityMargin * depth >= beta) {
+        return staticEval;
+    }
+
+    // Razoring, not done in a singular extension search for the same reason
+    if (canPrune && excludedMove == Move() && pruning.razoring && depth <= pruning.razoringMaxDepth &&
+        staticEval + pruning.razoringBaseMargin + pruning.razoringDepthMargin * depth <= alpha) {
+        int16_t eval = quiescence(game, alpha, beta, QUIESCENCE_DEPTH, state, ply);
+        if (eval <= alpha) return eval;
+    }
 
     // Null move pruning
-    if (allowNullMove) {
-        int16_t staticEval = Evaluation::evaluate(game, state, ply);
-        bool inCheck = (state == GameStateEvaluation::CHECK);
+    if (allowNullMove && excludedMove == Move() && !inCheck && depth >= 3 && staticEval >= beta && notZugzwangNullMovePruningCheck(board, colour)) {
+        playedMoves[ply] = PreviousMove();
+        game.makeNullMove();
+        GameStateEvaluation newState = game.getCurrentGameStateEvaluation();
+        const int NULL_MOVE_REDUCTION = (depth >= 6) ? 3 : 2;
+        int16_t nullEval = -negamax(game, depth - NULL_MOVE_REDUCTION - 1, -beta, -(beta - 1), newState, isPVNode, !cutNode, timeUp, ply + 1, extensionCount, false);
+        game.undoNullMove();
 
-        if (!inCheck && depth >= 3 && staticEval >= beta && notZugzwangNullMovePruningCheck(board, colour)) {
-            game.makeNullMove();
+        if (nullEval >= beta) {
+            return beta;
+        }
+    }
+
+    // ProbCut, a capture which beats beta by a margin in a reduced search is assumed to beat beta in the full search
+    const int16_t probCutBeta = beta + pruning.probCutMargin;
+    // Skipped if a transposition table entry of about the reduced depth already shows the node failing to reach the raised beta
+    if (canPrune && excludedMove == Move() && pruning.probCut && depth >= pruning.probCutMinDepth &&
+        !(entry && entry->depth >= depth - pruning.probCutReduction && entry->eval < probCutBeta && entry->flag != TTFlag::LOWER_BOUND)) {
+        // The buffer of this ply is free until the move picker is created
+        std::vector<Move>& captures = negamaxMoveBuffers[ply];
+        captures.clear();
+        MoveGenerator::pseudoLegalCaptures(board, colour, captures);
+
+        for (const Move move : captures) {
+            // Only captures which win enough material to make up the difference between the static evaluation and the raised beta
+            if (!Evaluation::staticExchangeAtLeast(board, move, probCutBeta - staticEval)) continue;
+            if (!MoveGenerator::isLegal(board, colour, move)) continue;
+
+            playedMoves[ply] = {board.getPiece(move.getFromSquare()), move.getToSquare()};
+            game.makeMove(move);
             GameStateEvaluation newState = game.getCurrentGameStateEvaluation();
-            const int NULL_MOVE_REDUCTION = (depth >= 6) ? 3 : 2;
-            int16_t nullEval = -negamax(game, depth - NULL_MOVE_REDUCTION - 1, -beta, -(beta - 1), newState, isPVNode, timeUp, ply + 1, extensionCount, false);
-            game.undoNullMove();
 
-            if (nullEval >= beta) {
-                return beta;
+            // Quiescence search first verifies the capture cheaply before the reduced search
+            int16_t eval = -quiescence(game, -probCutBeta, -(probCutBeta - 1), QUIESCENCE_DEPTH, newState, ply + 1);
+            if (eval >= probCutBeta) {
+                eval = -negamax(game, depth - pruning.probCutReduction - 1, -probCutBeta, -(probCutBeta - 1), newState, false, !cutNode,
+                                timeUp, ply + 1, extensionCount, allowNullMove);
             }
-        }   
+            game.undo();
+
+            if (timeUp()) return 0;
+
+            if (eval >= probCutBeta) {
+                stats.probCuts++;
+
+                // Stored at the reduced depth so that transpositions do not repeat the captures
+                TTEntry newEntry;
+                newEntry.zobristKey = hash;
+                newEntry.depth = depth - pruning.probCutReduction;
+                newEntry.eval = eval;
+                newEntry.generation = transpositionTable.getGeneration();
+                newEntry.flag = TTFlag::LOWER_BOUND;
+                newEntry.bestMove = move;
+                transpositionTable.add(hash, newEntry);
+
+                return eval;
+            }
+        }
     }
 
+    // Futility pruning, quiet moves are assumed unable to make up the difference between the static evaluation and alpha
+    const bool futilityPrune = canPrune && pruning.futilityPruning && depth <= pruning.futilityMaxDepth &&
+                               staticEval + pruning.futilityBaseMargin + pruning.futilityDepthMargin * depth <= alpha;
+
     int16_t originalAlpha = alpha;
     int16_t maxEval = std::numeric_limits<int16_t>::min() + 1;
     Move bestMove;
 
-    Move* ttMove = nullptr;
-    if (entry && entry->generation == transpositionTable.getGeneration() && entry->depth >= depth) {
-        ttMove = &entry->bestMove;
+    // Singular extension, the transposition table move is extended if every other move fails low by a margin in a reduced search
+    Move singularMove;
+    if (depth >= SINGULAR_EXTENSION_MIN_DEPTH && excludedMove == Move() && extensionCount < MAX_EXTENSION_COUNT &&
+        entry && entry->bestMove != Move() && entry->flag == TTFlag::LOWER_BOUND &&
+        entry->depth >= depth - SINGULAR_EXTENSION_TT_DEPTH_MARGIN && !Evaluation::isMateScore(entry->eval) &&
+        MoveGenerator::isPseudoLegal(board, colour, entry->bestMove) && MoveGenerator::isLegal(board, colour, entry->bestMove)) {
+
+        const Move candidate = entry->bestMove;
+        const int16_t singularBeta = entry->eval - SINGULAR_EXTENSION_MARGIN * depth;
+
+        excludedMoves[ply] = candidate;
+        int16_t singularEval = negamax(game, (depth - 1) / 2, singularBeta - 1, singularBeta, state, false, cutNode, timeUp, ply, extensionCount, false);
+        excludedMoves[ply] = Move();
+
+        if (timeUp()) return 0;
+
+        if (singularEval < singularBeta) {
+            singularMove = candidate;
+            stats.singularExtensions++;
+        } else if (singularBeta >= beta) {
+            // Multi-cut, the transposition table move and at least one other move are expected to beat beta
+            stats.multiCuts++;
+            return singularBeta;
+        }
     }
 
-    std::vector<Move>& moves = negamaxMoveBuffers[ply];
-    moves.clear();
-    MoveGenerator::pseudoLegalMoves(board, colour, moves);
-    Evaluation::orderMoves(moves, board, ply, colour, ttMove);
+    const PreviousMoves previousMoves = {playedMoves[ply - 1], (ply >= 2) ? playedMoves[ply - 2] : PreviousMove()};
+    MovePicker movePicker(board, colour, ttMove, ply, previousMoves, negamaxMoveBuffers[ply]);
+
+    std::array<Move, MAX_TRACKED_QUIETS> quietsSearched;
+    std::size_t quietCount = 0;
+    std::array<Move, MAX_TRACKED_CAPTURES> capturesSearched;
+    std::size_t captureCount = 0;
 
     int moveCount = 0;
-    for (const Move move : moves) {
-        game.makeMove(move);
+    Move move;
+    while ((move = movePicker.nextMove()) != Move()) {
+        if (move == excludedMove) continue;
+
+        const bool isQuiet = (move.getCapturedPiece() == Move::NO_CAPTURE && move.getPromotionPiece() == Move::NO_PROMOTION);
+
+        // At least one move is searched so that there is a best move
+        if (canPrune && isQuiet && moveCount > 0) {
+            // Late move pruning, the remaining quiet moves of a low depth node are unlikely to matter once enough moves are searched
+            if (pruning.lateMovePruning && depth < static_cast<int>(pruning.lateMovePruningCounts.size()) &&
+                moveCount >= pruning.lateMovePruningCounts[depth]) {
+                stats.lateMovePrunes++;
+                movePicker.skipQuiets();
+                continue;
+            }
+
+            // History pruning
+            if (pruning.historyPruning && depth <= pruning.historyPruningMaxDepth &&
+                Evaluation::historyOrderingScore(move, board.getPiece(move.getFromSquare()), colour, previousMoves) < -pruning.historyPruningMargin * depth) {
+                stats.historyPrunes++;
+                continue;
+            }
+        }
 
         // Illegal move
-        if (Check::isInCheck(board, colour)) {
+        if (!MoveGenerator::isLegal(board, colour, move)) continue;
+
+        playedMoves[ply] = {board.getPiece(move.getFromSquare()), move.getToSquare()};
+        game.makeMove(move);
+
+        // Quiet moves which give check are still searched
+        if (futilityPrune && moveCount > 0 && isQuiet && !board.checkers(opposingColour)) {
             game.undo();
             continue;
         }
 
         GameStateEvaluation newState = game.getCurrentGameStateEvaluation();
-        uint8_t extension = (newState == GameStateEvaluation::CHECK && extensionCount < MAX_EXTENSION_COUNT) ? 1 : 0;
+        uint8_t extension = ((newState == GameStateEvaluation::CHECK || move == singularMove) && extensionCount < MAX_EXTENSION_COUNT) ? 1 : 0;
         int newDepth = depth + extension - 1;
 
         // Late Move Reduction
@@ -204,29 +368,40 @@ int16_t Engine::negamax(Game& game, int depth, int16_t alpha, int16_t beta, Game
                                     !Evaluation::isKillerMove(move, ply));
 
         if (doLateMoveReduction) {
-            int reduction = 0.33 + std::log(depth) * std::log(moveCount) / 2.25;
+            int reduction = lateMoveReductionTable[std::min(depth, LMR_TABLE_SIZE - 1)][std::min(moveCount, LMR_TABLE_SIZE - 1)];
+            // The moved piece is on the target square as the move has been made
+            reduction -= Evaluation::historyOrderingScore(move, board.getPiece(move.getToSquare()), colour, previousMoves) / LMR_HISTORY_DIVISOR;
+            if (!improving) reduction++;
+            // Every move of a full window node is searched with a full window so only its largest reductions are lessened
+            if (!zeroWindow && reduction >= 3) reduction--;
+
+            reduction = std::max(reduction, 0);
             newDepth -= reduction;
 
             doLateMoveReduction = reduction > 0;
         }
 
+        // Children searched with the window of this node are expected to be cut nodes only below an all node
+        const bool windowChildCutNode = zeroWindow && !cutNode;
+
         int16_t eval;
         // PVS node
         if (isPVNode || moveCount == 0) {
-            eval = -negamax(game, newDepth, -beta, -alpha, newState, true, timeUp, ply + 1, extensionCount + extension, false);
+            eval = -negamax(game, newDepth, -beta, -alpha, newState, true, windowChildCutNode, timeUp, ply + 1, extensionCount + extension, false);
         } else {
-            // Zero-width non-PVS node search
-            eval = -negamax(game, newDepth, -(alpha + 1), -alpha, newState, false, timeUp, ply + 1, extensionCount + extension, allowNullMove);
+            // Zero-width non-PVS node search, a reduced move is expected to be refuted so its node is an expected cut node
+            eval = -negamax(game, newDepth, -(alpha + 1), -alpha, newState, false, doLateMoveReduction || !cutNode, timeUp,
+                            ply + 1, extensionCount + extension, allowNullMove);
 
             // Research if zero-width search fails
             if (eval > alpha && eval < beta) {
-                eval = -negamax(game, newDepth, -beta, -alpha, newState, false, timeUp, ply + 1, extensionCount + extension, allowNullMove);
+                eval = -negamax(game, newDepth, -beta, -alpha, newState, false, windowChildCutNode, timeUp, ply + 1, extensionCount + extension, allowNullMove);
             }
         }
 
         // Search again if Late Move Reduction fails
         if (doLateMoveReduction && eval > alpha && eval < beta) {
-            eval = -negamax(game, depth - 1 + extension, -beta, -alpha, newState, isPVNode, timeUp, ply + 1, extensionCount + extension, allowNullMove);
+            eval = -negamax(game, depth - 1 + extension, -beta, -alpha, newState, isPVNode, windowChildCutNode, timeUp, ply + 1, extensionCount + extension, allowNullMove);
         }
 
         game.undo();
@@ -240,15 +415,35 @@ int16_t Engine::negamax(Game& game, int depth, int16_t alpha, int16_t beta, Game
         }
         if (eval > alpha) alpha = eval;
         if (beta <= alpha) {
-            // Quiet move
-            if (move.getCapturedPiece() == Move::NO_CAPTURE && move.getPromotionPiece() == Move::NO_PROMOTION) {
+            if (isQuiet) {
                 Evaluation::addKillerMove(move, ply);
-                Evaluation::addHistoryHeuristic(move, board.getPiece(move.getFromSquare()), colour, depth);
+                Evaluation::setCounterMove(colour, previousMoves[0], move);
+                Evaluation::updateHistory(move, board.getPiece(move.getFromSquare()), colour, previousMoves, depth, true);
+
+                // Quiet moves searched before the cutoff failed to cause it
+                for (std::size_t i = 0; i < quietCount; i++) {
+                    const Move quiet = quietsSearched[i];
+                    Evaluation::updateHistory(quiet, board.getPiece(quiet.getFromSquare()), colour, previousMoves, depth, false);
+                }
+            } else if (move.getCapturedPiece() != Move::NO_CAPTURE) {
+                Evaluation::updateCaptureHistory(move, board.getPiece(move.getFromSquare()), colour, depth, true);
+            }
+
+            // Captures searched before the cutoff failed to cause it, whichever kind of move did
+            for (std::size_t i = 0; i < captureCount; i++) {
+                const Move capture = capturesSearched[i];
+                Evaluation::updateCaptureHistory(capture, board.getPiece(capture.getFromSquare()), colour, depth, false);
             }
             break;
         }
+
+        if (isQuiet && quietCount < MAX_TRACKED_QUIETS) quietsSearched[quietCount++] = move;
+        else if (move.getCapturedPiece() != Move::NO_CAPTURE && captureCount < MAX_TRACKED_CAPTURES) capturesSearched[captureCount++] = move;
     }
     
+    // The result without the excluded move must not replace the entry of the search with every move
+    if (excludedMove != Move()) return maxEval;
+
     TTEntry newEntry;
     newEntry.zobristKey = hash;
     newEntry.depth = depth;
@@ -262,13 +457,25 @@ int16_t Engine::negamax(Game& game, int depth, int16_t alpha, int16_t beta, Game
 
     transpositionTable.add(hash, newEntry);
 
+    // Correction history, a bound only measures the error of the static evaluation if it lies beyond it
+    // Captures and promotions are excluded as their result comes from the material won rather than the position
+    const bool quietBestMove = bestMove == Move() ||
+                               (bestMove.getCapturedPiece() == Move::NO_CAPTURE && bestMove.getPromotionPiece() == Move::NO_PROMOTION);
+    if (!inCheck && quietBestMove && !Evaluation::isMateScore(maxEval) &&
+        !(newEntry.flag == TTFlag::LOWER_BOUND && maxEval <= staticEval) &&
+        !(newEntry.flag == TTFlag::UPPER_BOUND && maxEval >= staticEval)) {
+        Evaluation::updateCorrectionHistory(colour, game.getPawnHash(), depth, maxEval, rawStaticEval);
+    }
+
     return maxEval;
 }
 
 int16_t Engine::quiescence(Game& game, int16_t alpha, int16_t beta, uint8_t qdepth, GameStateEvaluation state, uint8_t ply) {
+    stats.quiescenceNodes++;
     uint64_t hash = game.getHash();
-    TTEntry* entry = quiescenceTranspositionTable.getEntry(hash);
-    if (entry && entry->depth >= qdepth) {
+    // Entries of negamax searches are always deep enough, and quiescence search entries of the same or more remaining plies
+    TTEntry* entry = transpositionTable.getEntry(hash);
+    if (entry && entry->depth >= quiescenceEntryDepth(qdepth)) {
         if (entry->flag == TTFlag::EXACT ||
            (entry->flag == TTFlag::LOWER_BOUND && entry->eval >= beta) ||
            (entry->flag == TTFlag::UPPER_BOUND && entry->eval <= alpha)) {
@@ -280,10 +487,10 @@ int16_t Engine::quiescence(Game& game, int16_t alpha, int16_t beta, uint8_t qdep
 
     if (qdepth == 0 || (state != GameStateEvaluation::IN_PROGRESS && state != GameStateEvaluation::CHECK)) {
         maxDepthSearched = std::max(maxDepthSearched, ply);
-        return Evaluation::evaluate(game, state, ply);
+        return Evaluation::evaluate(game, state, ply, alpha, beta);
     }
 
-    int16_t currentEval = Evaluation::evaluate(game, state, ply);
+    int16_t currentEval = Evaluation::evaluate(game, state, ply, alpha, beta);
 
     // Standard pat
     int16_t bestEval = currentEval;
@@ -295,24 +502,27 @@ int16_t Engine::quiescence(Game& game, int16_t alpha, int16_t beta, uint8_t qdep
 
     Board& board = game.getBoard();
     Colour colour = game.getCurrentTurn();
-    Colour opposingColour = (colour == Colour::WHITE) ? Colour::BLACK : Colour::WHITE;
-
-    std::vector<Move>& moves = quiescenceMoveBuffers[qdepth];
-    moves.clear();
 
-    if (state != GameStateEvaluation::CHECK) {
-        MoveGenerator::pseudoLegalCaptures(board, colour, moves);
-        MoveGenerator::pseudoLegalQueenPromotions(board, colour, moves);
-        MoveGenerator::pseudoLegalNonCaptureChecks(board, colour, board.getKingSquare(opposingColour), moves);
-    } else {
-        MoveGenerator::pseudoLegalMoves(board, colour, moves);
+    // Outside of check only captures and queen promotions are searched, so other moves from negamax entries are not used
+    Move ttMove = transpositionTable.getBestMove(hash);
+    if (state != GameStateEvaluation::CHECK && ttMove.getCapturedPiece() == Move::NO_CAPTURE &&
+        ttMove.getPromotionPiece() != toIndex(Piece::QUEEN)) {
+        ttMove = Move();
     }
-    Evaluation::orderQuiescenceMoves(moves, board);
+
+    // Repeated quiet checks deeper in quiescence search rarely lead anywhere but multiply its nodes
+    const bool quietChecks = quiescenceChecksMode == QuiescenceChecksMode::ALL_PLIES ||
+                             (quiescenceChecksMode == QuiescenceChecksMode::FIRST_PLY && qdepth == QUIESCENCE_DEPTH);
+    MovePicker movePicker(board, colour, ttMove, quiescenceMoveBuffers[qdepth], state == GameStateEvaluation::CHECK, quietChecks);
 
     int16_t originalAlpha = alpha;
     Move bestMove;
 
-    for (const Move move : moves) {
+    std::array<Move, MAX_TRACKED_CAPTURES> capturesSearched;
+    std::size_t captureCount = 0;
+
+    Move move;
+    while ((move = movePicker.nextMove()) != Move()) {
         // Delta pruning
         uint8_t capturedPiece = move.getCapturedPiece();
         if (capturedPiece != Move::NO_CAPTURE) {
@@ -323,28 +533,34 @@ int16_t Engine::quiescence(Game& game, int16_t alpha, int16_t beta, uint8_t qdep
             }
         }
 
-        game.makeMove(move);
-
         // Illegal move
-        if (Check::isInCheck(board, colour)) {
-            game.undo();
-            continue;
-        }
+        if (!MoveGenerator::isLegal(board, colour, move)) continue;
+
+        game.makeMove(move);
 
         GameStateEvaluation newState = game.getCurrentGameStateEvaluation();
         int16_t eval = -quiescence(game, -beta, -alpha, qdepth - 1, newState, ply + 1);
         game.undo();
 
         if (eval >= beta) {
+            // Quiescence cutoffs are weighted as a search of depth 1
+            if (move.getCapturedPiece() != Move::NO_CAPTURE) {
+                Evaluation::updateCaptureHistory(move, board.getPiece(move.getFromSquare()), colour, 1, true);
+            }
+            for (std::size_t i = 0; i < captureCount; i++) {
+                const Move capture = capturesSearched[i];
+                Evaluation::updateCaptureHistory(capture, board.getPiece(capture.getFromSquare()), colour, 1, false);
+            }
+
             TTEntry newEntry;
             newEntry.zobristKey = hash;
-            newEntry.depth = qdepth;
+            newEntry.depth = quiescenceEntryDepth(qdepth);
             newEntry.eval = beta;
-            newEntry.generation = quiescenceTranspositionTable.getGeneration();
+            newEntry.generation = transpositionTable.getGeneration();
             newEntry.flag = TTFlag::LOWER_BOUND;
             newEntry.bestMove = move;
 
-            quiescenceTranspositionTable.add(hash, newEntry);
+            transpositionTable.add(hash, newEntry);
 
             return eval;
         }
@@ -355,20 +571,22 @@ int16_t Engine::quiescence(Game& game, int16_t alpha, int16_t beta, uint8_t qdep
         if (eval > alpha) {
             alpha = eval;
         }
+
+        if (move.getCapturedPiece() != Move::NO_CAPTURE && captureCount < MAX_TRACKED_CAPTURES) capturesSearched[captureCount++] = move;
     }
 
     TTEntry newEntry;
     newEntry.zobristKey = hash;
-    newEntry.depth = qdepth;
+    newEntry.depth = quiescenceEntryDepth(qdepth);
     newEntry.eval = bestEval;
-    newEntry.generation = quiescenceTranspositionTable.getGeneration();
+    newEntry.generation = transpositionTable.getGeneration();
     newEntry.bestMove = bestMove;
 
     if (bestEval <= originalAlpha) newEntry.flag = TTFlag::UPPER_BOUND;
     else if (bestEval >= beta) newEntry.flag = TTFlag::LOWER_BOUND;
     else newEntry.flag = TTFlag::EXACT;
 
-    quiescenceTranspositionTable.add(hash, newEntry);
+    transpositionTable.add(hash, newEntry);
 
     return bestEval;
 }
\ No newline at end of file
@@ -0,0 +1,18 @@
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+#include <bit>
+#include "engine/eval_cache.h"
+
+EvalCache::EvalCache(std::size_t size) :
+           TABLE_SIZE(std::bit_floor(size * 1024 * 1024 / sizeof(uint64_t))) {
+
+    table.resize(TABLE_SIZE);
+    clear();
+}
+
+void EvalCache::clear() {
+    std::fill(table.begin(), table.end(), 0);
+    probes = 0;
+    hits = 0;
+}
\ No newline at end of file
@@ -3,12 +3,19 @@
 #include <bit>
 #include <algorithm>
 #include <utility>
+#include <span>
+#include <cstdlib>
 #include "board/board.h"
 #include "move/move.h"
 #include "move/precompute_moves.h"
 #include "game/game.h"
 #include "chess_types.h"
 #include "engine/evaluation.h"
+#include "engine/pawn_hash_table.h"
+#include "engine/eval_cache.h"
+#include "engine/evaluation_context.h"
+#include "engine/evaluation_trace.h"
+#include "engine/nnue.h"
 #include "engine/piece_tables.h"
 #include "engine/precompute.h"
 
@@ -16,60 +23,38 @@ using Piece = Chess::PieceType;
 using Colour = Chess::PieceColour;
 using Chess::Bitboard;
 using Chess::toIndex;
-
-Move Evaluation::killerMoves[256][2];
-int16_t Evaluation::historyHeuristics[2][6][64][64];
+using Chess::fromIndex;
+
+thread_local Move Evaluation::killerMoves[256][2];
+thread_local int16_t Evaluation::historyHeuristics[2][6][64][64];
+thread_local int16_t Evaluation::continuationHistory[2][2][6][64][6][64];
+thread_local Move Evaluation::counterMoves[2][6][64];
+thread_local int16_t Evaluation::captureHistory[2][6][64][6];
+thread_local int16_t Evaluation::pawnCorrectionHistory[2][CORRECTION_HISTORY_SIZE];
+thread_local PawnHashTable Evaluation::pawnHashTable(PAWN_HASH_TABLE_SIZE);
+thread_local EvalCache Evaluation::evalCache(EVAL_CACHE_SIZE);
+EvaluationMode Evaluation::evaluationMode = EvaluationMode::CLASSICAL;
+bool Evaluation::lazyEvaluationEnabled = true;
+thread_local LazyEvaluationStats Evaluation::lazyEvaluationStats;
+
+#ifdef EVALUATION_TRACE
+thread_local EvaluationTrace Evaluation::trace {};
+#endif
 
 int16_t Evaluation::gamePhase(Board& board) {
-    constexpr Piece pieces[4] = {Piece::KNIGHT, Piece::BISHOP, Piece::ROOK, Piece::QUEEN};
-    constexpr Colour colours[2] = {Colour::WHITE, Colour::BLACK};
-    constexpr int phaseValues[6] = {0, 1, 1, 2, 4, 0};
-    
-    int totalPhase = 0;
-    for (Colour colour : colours) {
-        for (Piece piece : pieces) {
-            Bitboard bitboard = board.getBitboard(piece, colour);
-            totalPhase += std::popcount(bitboard) * phaseValues[toIndex(piece)];
-        }
-    }
-    
-    return std::min(totalPhase, Evaluation::MAX_PHASE);
+    return std::min<int16_t>(board.getPhase(), Evaluation::MAX_PHASE);
 }
 
-int16_t Evaluation::pieceValueEvaluation(Board& board, Colour colour, int16_t phase) {
-    constexpr Piece pieces[6] = {Piece::PAWN, Piece::KNIGHT, Piece::BISHOP, Piece::ROOK, Piece::QUEEN, Piece::KING};
+void Evaluation::evaluatePawnStructure(Board& board, Colour colour, PawnHashEntry& entry) {
     const Colour opposingColour = (colour == Colour::WHITE) ? Colour::BLACK : Colour::WHITE;
-    const uint8_t kingSquare = board.getKingSquare(colour);
-    const uint8_t opposingKingSquare = board.getKingSquare(opposingColour);
-    const uint8_t kingFile = Board::getFile(kingSquare);
-    const uint8_t opposingKingFile = Board::getFile(opposingKingSquare);
-    const uint8_t opposingKingRank = Board::getRank(opposingKingSquare);
-
-    const Bitboard allPiecesBitboard = board.getPiecesBitboard();
-    const Bitboard piecesBitboard = board.getBitboard(colour);
     const Bitboard pawnsBitboard = board.getBitboard(Piece::PAWN, colour);
     const Bitboard opposingPawnsBitboard = board.getBitboard(Piece::PAWN, opposingColour);
-    const Bitboard allPawnsBitboard = pawnsBitboard | opposingPawnsBitboard;
 
     uint8_t c = toIndex(colour);
     uint8_t oc = toIndex(opposingColour);
-    int32_t phasedEval = 0;
-    int16_t eval = 0;
-
-    for (uint8_t i = 0; i < 6; i++) {
-        Bitboard bitboard = board.getBitboard(pieces[i], colour);
-        while (bitboard) {
-            // Piece evaluation
-            eval += pieceEvals[i];
-
-            // Piece Square Table evaluation
-            uint8_t square = std::countr_zero(bitboard);
-            if (colour == Colour::WHITE) square ^= 0x38; // Flip square from black to white's perspective
-            phasedEval += PieceTables::tables[i][square] * phase + PieceTables::endgameTables[i][square] * (MAX_PHASE - phase);
-
-            bitboard &= (bitboard - 1);
-        }
-    }
+    Score score;
+    Bitboard passedPawns = 0ULL;
+    Bitboard backwardPawnCandidates = 0ULL;
 
     // Pawn structure penalties
     for (uint8_t file = 0; file < 8; file++) {
@@ -77,12 +62,14 @@ int16_t Evaluation::pieceValueEvaluation(Board& board, Colour colour, int16_t ph
         uint8_t pawnCount = std::popcount(pawnsBitboard & mask);
 
         // Penalty for doubling pawns
-        phasedEval += (pawnCount - 1) * (phase * DOUBLED_PAWN_PENALTY + (MAX_PHASE - phase) * DOUBLED_PAWN_PENALTY_END_GAME);
+        score += DOUBLED_PAWN_PENALTY * (pawnCount - 1);
+        TRACE_TERM(doubledPawns[c], pawnCount - 1);
 
         // Penalty for isolated pawns
         uint64_t isolatedMask = EnginePrecompute::adjacentFileMaskTable[file];
         if (pawnsBitboard & isolatedMask) continue; // Contains pawn on either immediate left or right file
-        phasedEval += pawnCount * (phase * ISOLATED_PAWN_PENALTY + (MAX_PHASE - phase) * ISOLATED_PAWN_PENALTY_END_GAME);
+        score += ISOLATED_PAWN_PENALTY * pawnCount;
+        TRACE_TERM(isolatedPawns[c], pawnCount);
     }
 
     Bitboard pawnsBitboardTemp = pawnsBitboard;
@@ -92,9 +79,9 @@ int16_t Evaluation::pieceValueEvaluation(Board& board, Colour colour, int16_t ph
         uint64_t backwardMask = EnginePrecompute::backwardPawnMaskTable[c][square];
         uint64_t pawnThreatMask = PrecomputeMoves::pawnThreatTable[oc][nextSquare];
 
-        // Is backward pawn
-        if (board.isEmpty(nextSquare) && !(pawnsBitboard & backwardMask) && (board.getBitboard(Piece::PAWN, opposingColour) & pawnThreatMask)) {
-            phasedEval += phase * BACKWARD_PAWN_PENALTY + (MAX_PHASE - phase) * BACKWARD_PAWN_PENALTY_END_GAME;
+        // Is backward pawn (if the square in front is also empty)
+        if (!(pawnsBitboard & backwardMask) && (opposingPawnsBitboard & pawnThreatMask)) {
+            backwardPawnCandidates |= (1ULL << square);
         }
 
         // Is part of a pawn chain
@@ -102,32 +89,181 @@ int16_t Evaluation::pieceValueEvaluation(Board& board, Colour colour, int16_t ph
         uint64_t pawnChainBitboard = pawnsBitboard & pawnChainMask;
         if (pawnChainBitboard) {
             uint8_t chainsCount = std::popcount(pawnChainBitboard); // Number of chains it is part of (1 or 2)
-            phasedEval += chainsCount * (phase * PAWN_CHAIN_BONUS + (MAX_PHASE - phase) * PAWN_CHAIN_BONUS_END_GAME);
+            score += PAWN_CHAIN_BONUS * chainsCount;
+            TRACE_TERM(pawnChains[c], chainsCount);
         }
 
         // Is a passed pawn
         uint64_t passedPawnMask = EnginePrecompute::passedPawnMaskTable[c][square];
-        if (!(passedPawnMask & board.getBitboard(Piece::PAWN, opposingColour))) {
+        if (!(passedPawnMask & opposingPawnsBitboard)) {
             uint8_t effectiveSquare = (colour == Colour::WHITE) ? square ^ 0x38 : square;
-            phasedEval += (
-                PieceTables::passedPawnTables[0][effectiveSquare] * phase + 
-                PieceTables::passedPawnTables[1][effectiveSquare] * (MAX_PHASE - phase)
-            );
+            score += PieceTables::packedPassedPawnTable[effectiveSquare];
+            TRACE_TERM(passedPawns[effectiveSquare][c], 1);
+            passedPawns |= (1ULL << square);
         }
 
         pawnsBitboardTemp &= (pawnsBitboardTemp - 1);
     }
 
+    entry.scores[c] = score;
+    entry.passedPawns[c] = passedPawns;
+    entry.backwardPawnCandidates[c] = backwardPawnCandidates;
+}
+
+const PawnHashEntry& Evaluation::probePawnStructure(Board& board, uint64_t pawnHash) {
+#ifndef EVALUATION_TRACE
+    // Cached entries carry no trace so the pawn structure is always evaluated when tracing
+    PawnHashEntry* entry = pawnHashTable.getEntry(pawnHash);
+    if (entry) return *entry;
+#endif
+
+    PawnHashEntry newEntry {};
+    evaluatePawnStructure(board, Colour::WHITE, newEntry);
+    evaluatePawnStructure(board, Colour::BLACK, newEntry);
+
+    return pawnHashTable.add(pawnHash, newEntry);
+}
+
+void Evaluation::buildEvaluationContext(Board& board, EvaluationContext& context) {
+    constexpr Colour colours[2] = {Colour::WHITE, Colour::BLACK};
+    constexpr Piece attackingPieces[4] = {Piece::KNIGHT, Piece::BISHOP, Piece::ROOK, Piece::QUEEN};
+    const Bitboard allPiecesBitboard = board.getPiecesBitboard();
+
+    for (Colour colour : colours) {
+        const Colour opposingColour = (colour == Colour::WHITE) ? Colour::BLACK : Colour::WHITE;
+        const uint8_t c = toIndex(colour);
+        const Bitboard opposingKingZone = PrecomputeMoves::kingMoveTable[board.getKingSquare(opposingColour)];
+        uint8_t count = 0;
+
+        // Pawn attacks
+        Bitboard pawnAttacks = 0ULL;
+        uint8_t pawnKingZoneAttacks = 0;
+        Bitboard pawnsBitboard = board.getBitboard(Piece::PAWN, colour);
+        while (pawnsBitboard) {
+            uint8_t square = std::countr_zero(pawnsBitboard);
+            Bitboard attacks = PrecomputeMoves::pawnCaptureTable[c][square];
+            pawnAttacks |= attacks;
+            pawnKingZoneAttacks += std::popcount(attacks & opposingKingZone);
+
+            pawnsBitboard &= pawnsBitboard - 1;
+        }
+        context.attacks[c][toIndex(Piece::PAWN)] = pawnAttacks;
+        context.kingZoneAttacks[c][toIndex(Piece::PAWN)] = pawnKingZoneAttacks;
+
+        // Knight, bishop, rook and queen attacks
+        for (Piece piece : attackingPieces) {
+            const uint8_t p = toIndex(piece);
+            Bitboard pieceTypeAttacks = 0ULL;
+            uint8_t pieceTypeKingZoneAttacks = 0;
+
+            Bitboard bitboard = board.getBitboard(piece, colour);
+            while (bitboard) {
+                uint8_t square = std::countr_zero(bitboard);
+                Bitboard attacks = 0ULL;
+                switch (piece) {
+                    case Piece::KNIGHT:
+                        attacks = PrecomputeMoves::knightMoveTable[square];
+                        break;
+                    case Piece::BISHOP:
+                        attacks = PrecomputeMoves::getBishopMovesFromTable(square, allPiecesBitboard);
+                        break;
+                    case Piece::ROOK:
+                        attacks = PrecomputeMoves::getRookMovesFromTable(square, allPiecesBitboard);
+                        break;
+                    case Piece::QUEEN:
+                        attacks = PrecomputeMoves::getBishopMovesFromTable(square, allPiecesBitboard) |
+                                    PrecomputeMoves::getRookMovesFromTable(square, allPiecesBitboard);
+                        break;
+                    default:
+                        attacks = 0ULL;
+                }
+
+                pieceTypeAttacks |= attacks;
+                pieceTypeKingZoneAttacks += std::popcount(attacks & opposingKingZone);
+                if (count < EvaluationContext::MAX_PIECES) {
+                    context.pieceAttacks[c][count++] = {attacks, square, piece};
+                }
+
+                bitboard &= bitboard - 1;
+            }
+
+            context.attacks[c][p] = pieceTypeAttacks;
+            context.kingZoneAttacks[c][p] = pieceTypeKingZoneAttacks;
+        }
+
+        // King attacks
+        const Bitboard kingAttacks = PrecomputeMoves::kingMoveTable[board.getKingSquare(colour)];
+        context.attacks[c][toIndex(Piece::KING)] = kingAttacks;
+        context.kingZoneAttacks[c][toIndex(Piece::KING)] = std::popcount(kingAttacks & opposingKingZone);
+
+        context.pieceAttacksCount[c] = count;
+        context.attackedBy[c] = 0ULL;
+        for (uint8_t i = 0; i < 6; i++) {
+            context.attackedBy[c] |= context.attacks[c][i];
+        }
+    }
+}
+
+Score Evaluation::pieceValueEvaluation(Board& board, Colour colour, const PawnHashEntry& pawnEntry, const EvaluationContext& context) {
+    const Colour opposingColour = (colour == Colour::WHITE) ? Colour::BLACK : Colour::WHITE;
+    const uint8_t kingSquare = board.getKingSquare(colour);
+    const uint8_t opposingKingSquare = board.getKingSquare(opposingColour);
+    const uint8_t kingFile = Board::getFile(kingSquare);
+    const uint8_t opposingKingFile = Board::getFile(opposingKingSquare);
+    const uint8_t opposingKingRank = Board::getRank(opposingKingSquare);
+
+    const Bitboard allPiecesBitboard = board.getPiecesBitboard();
+    const Bitboard piecesBitboard = board.getBitboard(colour);
+    const Bitboard pawnsBitboard = board.getBitboard(Piece::PAWN, colour);
+    const Bitboard opposingPawnsBitboard = board.getBitboard(Piece::PAWN, opposingColour);
+    const Bitboard allPawnsBitboard = pawnsBitboard | opposingPawnsBitboard;
+
+    uint8_t c = toIndex(colour);
+    uint8_t oc = toIndex(opposingColour);
+    Score eval;
+
+    // Material and piece square table evaluation (maintained incrementally by the board)
+    const int16_t material = board.getMaterial(colour);
+    eval += Score(material, material);
+    eval += board.getPieceSquareScore(colour);
+
+#ifdef EVALUATION_TRACE
+    for (uint8_t p = 0; p < 6; p++) {
+        Bitboard bitboard = board.getBitboard(fromIndex<Piece>(p), colour);
+        while (bitboard) {
+            uint8_t square = std::countr_zero(bitboard);
+            uint8_t tableSquare = (colour == Colour::WHITE) ? square ^ 0x38 : square; // Flip square from black to white's perspective
+            TRACE_TERM(pieceSquares[p][tableSquare][c], 1);
+
+            bitboard &= bitboard - 1;
+        }
+    }
+#endif
+
+    // Pawn structure (doubled, isolated, backward, pawn chain and passed pawns) cached by pawn hash
+    eval += pawnEntry.scores[c];
+
+    // Backward pawns also require the square in front of them to be empty
+    {
+        Bitboard emptyBitboard = ~allPiecesBitboard;
+        Bitboard emptyInFrontBitboard = (colour == Colour::WHITE) ? emptyBitboard >> 8 : emptyBitboard << 8;
+        uint8_t backwardPawnCount = std::popcount(pawnEntry.backwardPawnCandidates[c] & emptyInFrontBitboard);
+        eval += BACKWARD_PAWN_PENALTY * backwardPawnCount;
+        TRACE_TERM(backwardPawns[c], backwardPawnCount);
+    }
+
     // Major pawn shield bonus
     {
         Bitboard majorPawnsShieldBitboard = EnginePrecompute::majorPawnShieldTable[c][kingSquare] & pawnsBitboard;
-        phasedEval += phase * std::popcount(majorPawnsShieldBitboard) * MAJOR_PAWN_SHIELD_BONUS;
+        eval += MAJOR_PAWN_SHIELD_BONUS * std::popcount(majorPawnsShieldBitboard);
+        TRACE_TERM(majorPawnShields[c], std::popcount(majorPawnsShieldBitboard));
     }
 
     // Minor pawn shield bonus
     {
         Bitboard minorPawnsShieldBitboard = EnginePrecompute::minorPawnShieldTable[c][kingSquare] & pawnsBitboard;
-        phasedEval += phase * std::popcount(minorPawnsShieldBitboard) * MINOR_PAWN_SHIELD_BONUS;
+        eval += MINOR_PAWN_SHIELD_BONUS * std::popcount(minorPawnsShieldBitboard);
+        TRACE_TERM(minorPawnShields[c], std::popcount(minorPawnsShieldBitboard));
     }
 
     // King tropism bonuses
@@ -139,7 +275,8 @@ int16_t Evaluation::pieceValueEvaluation(Board& board, Colour colour, int16_t ph
             uint8_t distance = EnginePrecompute::chebyshevDistanceTable[opposingKingSquare][square];
             
             if (distance < MAX_TROPISM_DISTANCE) {
-                phasedEval += phase * KING_TROPISM_BONUSES[i] * (MAX_TROPISM_DISTANCE - distance);
+                eval += KING_TROPISM_BONUSES[i] * (MAX_TROPISM_DISTANCE - distance);
+                TRACE_TERM(kingTropism[i][c], MAX_TROPISM_DISTANCE - distance);
             }
 
             bitboard &= bitboard - 1;
@@ -154,10 +291,12 @@ int16_t Evaluation::pieceValueEvaluation(Board& board, Colour colour, int16_t ph
         
         // Open file
         if (!(allPawnsBitboard & openFileMask)) {
-            phasedEval += phase * ROOK_OPEN_FILE_BONUS + (MAX_PHASE - phase) * ROOK_OPEN_FILE_BONUS_END_GAME;
+            eval += ROOK_OPEN_FILE_BONUS;
+            TRACE_TERM(rookOpenFiles[c], 1);
         // Semi-open file
         } else if (!(pawnsBitboard & openFileMask)) {
-            phasedEval += phase * ROOK_SEMI_OPEN_FILE_BONUS + (MAX_PHASE - phase) * ROOK_SEMI_OPEN_FILE_BONUS_END_GAME;
+            eval += ROOK_SEMI_OPEN_FILE_BONUS;
+            TRACE_TERM(rookSemiOpenFiles[c], 1);
         }
 
         rooksBitboardTemp &= rooksBitboardTemp - 1;
@@ -171,10 +310,12 @@ int16_t Evaluation::pieceValueEvaluation(Board& board, Colour colour, int16_t ph
         
         // Open file
         if (!(allPawnsBitboard & openFileMask)) {
-            phasedEval += phase * QUEEN_OPEN_FILE_BONUS + (MAX_PHASE - phase) * QUEEN_OPEN_FILE_BONUS_END_GAME;
+            eval += QUEEN_OPEN_FILE_BONUS;
+            TRACE_TERM(queenOpenFiles[c], 1);
         // Semi-open file
         } else if (!(pawnsBitboard & openFileMask)) {
-            phasedEval += phase * QUEEN_SEMI_OPEN_FILE_BONUS + (MAX_PHASE - phase) * QUEEN_SEMI_OPEN_FILE_BONUS_END_GAME;
+            eval += QUEEN_SEMI_OPEN_FILE_BONUS;
+            TRACE_TERM(queenSemiOpenFiles[c], 1);
         }
 
         queensBitboardTemp &= queensBitboardTemp - 1;
@@ -190,10 +331,12 @@ int16_t Evaluation::pieceValueEvaluation(Board& board, Colour colour, int16_t ph
 
             // Open file
             if (!(allPawnsBitboard & openFileMask)) {
-                phasedEval += phase * OPEN_FILE_NEAR_KING_PENALTY;
+                eval += OPEN_FILE_NEAR_KING_PENALTY;
+                TRACE_TERM(openFilesNearKing[c], 1);
             // Semi-open file
             } else if (!(pawnsBitboard & openFileMask)) {
-                phasedEval += phase * SEMI_OPEN_FILE_NEAR_KING_PENALTY;
+                eval += SEMI_OPEN_FILE_NEAR_KING_PENALTY;
+                TRACE_TERM(semiOpenFilesNearKing[c], 1);
             }
         }
     }
@@ -201,64 +344,27 @@ int16_t Evaluation::pieceValueEvaluation(Board& board, Colour colour, int16_t ph
     // Opposing pieces attacking in king zone penalty
     {
         constexpr Piece kingZoneAttacksPieces[5] = {Piece::PAWN, Piece::KNIGHT, Piece::BISHOP, Piece::ROOK, Piece::QUEEN};
-        Bitboard kingZone = PrecomputeMoves::kingMoveTable[kingSquare];
 
         for (uint8_t i = 0; i < 4; i++) {
-            Bitboard bitboard = board.getBitboard(kingZoneAttacksPieces[i], opposingColour);
-            while (bitboard) {
-                uint8_t square = std::countr_zero(bitboard);
-                Bitboard attacks = 0ULL;
-                switch (kingZoneAttacksPieces[i]) {
-                    case Piece::PAWN:
-                        attacks = PrecomputeMoves::pawnCaptureTable[oc][square];
-                        break;
-                    case Piece::KNIGHT:
-                        attacks = PrecomputeMoves::knightMoveTable[square];
-                        break;
-                    case Piece::BISHOP:
-                        attacks = PrecomputeMoves::getBishopMovesFromTable(square, allPiecesBitboard);
-                        break;
-                    case Piece::ROOK:
-                        attacks = PrecomputeMoves::getRookMovesFromTable(square, allPiecesBitboard);
-                        break;
-                    case Piece::QUEEN:
-                        attacks = PrecomputeMoves::getBishopMovesFromTable(square, allPiecesBitboard) |
-                                    PrecomputeMoves::getRookMovesFromTable(square, allPiecesBitboard);
-                        break;
-                    default:
-                        attacks = 0ULL;
-                }
-
-                Bitboard kingZoneAttacks = attacks & kingZone;
-                phasedEval += phase * std::popcount(kingZoneAttacks) * KING_ZONE_ATTACK_PENALTIES[i];
-
-                bitboard &= bitboard - 1;
-            }
+            uint8_t kingZoneAttacks = context.kingZoneAttacks[oc][toIndex(kingZoneAttacksPieces[i])];
+            eval += KING_ZONE_ATTACK_PENALTIES[i] * kingZoneAttacks;
+            TRACE_TERM(kingZoneAttacks[i][c], kingZoneAttacks);
         }
     }
 
-    // Bishop mobility bonus
-    Bitboard bishopsBitboardTemp = board.getBitboard(Piece::BISHOP, colour);
-    while (bishopsBitboardTemp) {
-        uint8_t square = std::countr_zero(bishopsBitboardTemp);
-        Bitboard bishopMoves = PrecomputeMoves::getBishopMovesFromTable(square, allPiecesBitboard);
-        bishopMoves &= ~piecesBitboard; // Remove squares which land onto same colour pieces
-        uint8_t mobility = std::popcount(bishopMoves); // Number of squares that the bishop can move to
-        phasedEval += phase * BISHOP_MOBILITY_BONUSES[mobility] + (MAX_PHASE - phase) * BISHOP_MOBILITY_BONUSES_END_GAME[mobility];
-
-        bishopsBitboardTemp &= bishopsBitboardTemp - 1;
-    }
-
-    // Knight mobility bonus
-    Bitboard knightsBitboardTemp = board.getBitboard(Piece::KNIGHT, colour);
-    while (knightsBitboardTemp) {
-        uint8_t square = std::countr_zero(knightsBitboardTemp);
-        Bitboard knightMoves = PrecomputeMoves::knightMoveTable[square];
-        knightMoves &= ~piecesBitboard; // Remove squares which land onto same colour pieces
-        uint8_t mobility = std::popcount(knightMoves); // Number of squares that the knight can move to
-        phasedEval += phase * KNIGHT_MOBILITY_BONUSES[mobility] + (MAX_PHASE - phase) * KNIGHT_MOBILITY_BONUSES_END_GAME[mobility];
-
-        knightsBitboardTemp &= knightsBitboardTemp - 1;
+    // Bishop and knight mobility bonus
+    for (uint8_t i = 0; i < context.pieceAttacksCount[c]; i++) {
+        const PieceAttacks& pieceAttacks = context.pieceAttacks[c][i];
+        Bitboard moves = pieceAttacks.attacks & ~piecesBitboard; // Remove squares which land onto same colour pieces
+        uint8_t mobility = std::popcount(moves); // Number of squares that the piece can move to
+
+        if (pieceAttacks.piece == Piece::BISHOP) {
+            eval += BISHOP_MOBILITY_BONUSES[mobility];
+            TRACE_TERM(bishopMobility[mobility][c], 1);
+        } else if (pieceAttacks.piece == Piece::KNIGHT) {
+            eval += KNIGHT_MOBILITY_BONUSES[mobility];
+            TRACE_TERM(knightMobility[mobility][c], 1);
+        }
     }
 
     // Connected rooks bonus
@@ -273,12 +379,14 @@ int16_t Evaluation::pieceValueEvaluation(Board& board, Colour colour, int16_t ph
             if (Board::getFile(square1) == Board::getFile(square2)) {
                 uint64_t squaresBetweenMask = EnginePrecompute::sameFileSquaresBetweenTable[square1][square2];
                 if (!(squaresBetweenMask & allPiecesBitboard)) {
-                    phasedEval += phase * CONNECTED_ROOK_BONUS + (MAX_PHASE - phase) * CONNECTED_ROOK_BONUS_END_GAME;
+                    eval += CONNECTED_ROOK_BONUS;
+                    TRACE_TERM(connectedRooks[c], 1);
                 }
             } else if (Board::getRank(square1) == Board::getRank(square2)) {
                 uint64_t squaresBetweenMask = EnginePrecompute::sameRankSquaresBetweenTable[square1][square2];
                 if (!(squaresBetweenMask & allPiecesBitboard)) {
-                    phasedEval += phase * CONNECTED_ROOK_BONUS + (MAX_PHASE - phase) * CONNECTED_ROOK_BONUS_END_GAME;
+                    eval += CONNECTED_ROOK_BONUS;
+                    TRACE_TERM(connectedRooks[c], 1);
                 }
             }
 
@@ -314,7 +422,8 @@ int16_t Evaluation::pieceValueEvaluation(Board& board, Colour colour, int16_t ph
         if (currentFilePawnAdvance >= 3 && rightFilePawnAdvance >= 3) {
             // Pawns must be within 2 files of the king
             if (opposingKingFile >= file - 1 && opposingKingFile <= file + 2) {
-                phasedEval += phase * PAWN_STORM_BONUS;
+                eval += PAWN_STORM_BONUS;
+                TRACE_TERM(pawnStorms[c], 1);
 
                 uint8_t currentFilePawnRankDistance = (currentFilePawnRank >= opposingKingRank) ? 
                                                         currentFilePawnRank - opposingKingRank :
@@ -330,7 +439,8 @@ int16_t Evaluation::pieceValueEvaluation(Board& board, Colour colour, int16_t ph
 
                 // Bonus for pawn storms close to the king
                 if (distance <= 2) {
-                    phasedEval += phase * PAWN_STORM_PROXIMITY_BONUS * (3 - distance);
+                    eval += PAWN_STORM_PROXIMITY_BONUS * (3 - distance);
+                    TRACE_TERM(pawnStormProximity[c], 3 - distance);
                 }
 
                 break; // Only include 1 pawn storm in evaluation
@@ -338,13 +448,11 @@ int16_t Evaluation::pieceValueEvaluation(Board& board, Colour colour, int16_t ph
         }
     }
 
-    eval += phasedEval / MAX_PHASE;
-
     return eval;
 }
 
 void Evaluation::orderMoves(std::vector<Move>& moves, Board& board, uint8_t ply, Colour colour, const Move* bestMove) {
-    static std::vector<std::pair<Move, std::pair<MoveType, int32_t>>> scoredMovesBuffer;
+    static thread_local std::vector<std::pair<Move, std::pair<MoveType, int32_t>>> scoredMovesBuffer;
     scoredMovesBuffer.clear();
     scoredMovesBuffer.reserve(moves.size());
 
@@ -366,10 +474,76 @@ void Evaluation::orderMoves(std::vector<Move>& moves, Board& board, uint8_t ply,
     }
 }
 
-void Evaluation::orderQuiescenceMoves(std::vector<Move>& moves, Board& board) {
-    std::sort(moves.begin(), moves.end(), [&board](const Move a, const Move b) {
-        return orderingQuiescenceScore(a, board) > orderingQuiescenceScore(b, board);
-    });
+bool Evaluation::staticExchangeAtLeast(Board& board, const Move move, int16_t threshold) {
+    if (move.getCastling() != Move::NO_CASTLE) return threshold <= 0;
+
+    const uint8_t fromSquare = move.getFromSquare();
+    const uint8_t toSquare = move.getToSquare();
+    const uint8_t capturedPiece = move.getCapturedPiece();
+
+    // Balance of the exchange relative to the threshold after the move, assuming the moved piece is lost
+    int32_t swap = ((capturedPiece != Move::NO_CAPTURE) ? pieceEvals[capturedPiece] : 0) - threshold;
+    if (swap < 0) return false;
+
+    swap = pieceEvals[toIndex(board.getPiece(fromSquare))] - swap;
+    if (swap <= 0) return true;
+
+    Bitboard occupied = board.getPiecesBitboard() & ~(1ULL << fromSquare);
+    if (move.getEnPassant()) {
+        occupied &= ~(1ULL << ((fromSquare & ~0x7) | (toSquare & 0x7))); // Captured pawn is beside the capturing pawn
+    }
+
+    const Bitboard bishopsQueens = board.getBitboard(Piece::BISHOP, Colour::WHITE) | board.getBitboard(Piece::BISHOP, Colour::BLACK) |
+                                   board.getBitboard(Piece::QUEEN, Colour::WHITE) | board.getBitboard(Piece::QUEEN, Colour::BLACK);
+    const Bitboard rooksQueens = board.getBitboard(Piece::ROOK, Colour::WHITE) | board.getBitboard(Piece::ROOK, Colour::BLACK) |
+                                 board.getBitboard(Piece::QUEEN, Colour::WHITE) | board.getBitboard(Piece::QUEEN, Colour::BLACK);
+
+    Colour colour = board.getColour(fromSquare);
+    Bitboard attackers = board.attackersTo(toSquare, occupied);
+    bool result = true; // True if the player who made the last capture reaches the threshold
+
+    constexpr Piece capturingOrder[5] = {Piece::PAWN, Piece::KNIGHT, Piece::BISHOP, Piece::ROOK, Piece::QUEEN};
+    while (true) {
+        colour = (colour == Colour::WHITE) ? Colour::BLACK : Colour::WHITE;
+        attackers &= occupied;
+
+        Bitboard colourAttackers = attackers & board.getBitboard(colour);
+        if (!colourAttackers) break;
+
+        result = !result;
+
+        // Capture with the least valuable attacker
+        Piece attacker = Piece::KING;
+        Bitboard attackerBitboard = 0ULL;
+        for (Piece piece : capturingOrder) {
+            attackerBitboard = colourAttackers & board.getBitboard(piece, colour);
+            if (attackerBitboard) {
+                attacker = piece;
+                break;
+            }
+        }
+
+        // The king can only capture if the square is no longer defended
+        if (attacker == Piece::KING) {
+            if (attackers & ~board.getBitboard(colour)) result = !result;
+            break;
+        }
+
+        swap = pieceEvals[toIndex(attacker)] - swap;
+        if (swap < result) break;
+
+        occupied &= ~(attackerBitboard & -attackerBitboard);
+
+        // Sliders behind the capturing piece join the exchange
+        if (attacker == Piece::PAWN || attacker == Piece::BISHOP || attacker == Piece::QUEEN) {
+            attackers |= PrecomputeMoves::getBishopMovesFromTable(toSquare, occupied) & bishopsQueens;
+        }
+        if (attacker == Piece::ROOK || attacker == Piece::QUEEN) {
+            attackers |= PrecomputeMoves::getRookMovesFromTable(toSquare, occupied) & rooksQueens;
+        }
+    }
+
+    return result;
 }
 
 int16_t Evaluation::evaluate(Game& game, GameStateEvaluation state, uint8_t ply) {
@@ -380,13 +554,85 @@ int16_t Evaluation::evaluate(Game& game, GameStateEvaluation state, uint8_t ply)
         return 0;
     }
 
+    const uint64_t hash = game.getHash();
+    int16_t eval;
+    if (evalCache.probe(hash, eval)) return eval;
+
+    eval = staticEvaluation(game);
+
+    evalCache.add(hash, eval);
+    return eval;
+}
+
+int16_t Evaluation::evaluate(Game& game, GameStateEvaluation state, uint8_t ply, int16_t alpha, int16_t beta) {
+    if (!lazyEvaluationEnabled || (evaluationMode == EvaluationMode::NNUE && NNUE::isLoaded()) ||
+        (state != GameStateEvaluation::IN_PROGRESS && state != GameStateEvaluation::CHECK)) {
+
+        return evaluate(game, state, ply);
+    }
+
+    const uint64_t hash = game.getHash();
+    int16_t eval;
+    if (evalCache.probe(hash, eval)) return eval;
+
+    // The remaining terms are unlikely to move the evaluation back inside the window
+    // The edge of the margin closest to the window is returned as fail soft callers keep and store the value
+    lazyEvaluationStats.calls++;
+    int16_t lazyEval = lazyEvaluation(game);
+    if (lazyEval - LAZY_EVALUATION_TYPICAL_MARGIN >= beta) {
+        lazyEvaluationStats.exits++;
+        return lazyEval - LAZY_EVALUATION_TYPICAL_MARGIN;
+    }
+    if (lazyEval + LAZY_EVALUATION_TYPICAL_MARGIN <= alpha) {
+        lazyEvaluationStats.exits++;
+        return lazyEval + LAZY_EVALUATION_TYPICAL_MARGIN;
+    }
+
+    eval = staticEvaluation(game);
+
+    evalCache.add(hash, eval);
+    return eval;
+}
+
+int16_t Evaluation::lazyEvaluation(Game& game) {
     Board& board = game.getBoard();
     Colour currentColour = game.getCurrentTurn();
+    Colour opposingColour = (currentColour == Colour::WHITE) ? Colour::BLACK : Colour::WHITE;
+
+    int16_t material = board.getMaterial(currentColour) - board.getMaterial(opposingColour);
+    Score score = Score(material, material) + board.getPieceSquareScore(currentColour) - board.getPieceSquareScore(opposingColour);
+
+    return static_cast<int16_t>(score.interpolate(gamePhase(board), MAX_PHASE));
+}
+
+int16_t Evaluation::staticEvaluation(Game& game) {
+    Board& board = game.getBoard();
+    Colour currentColour = game.getCurrentTurn();
+
+    if (evaluationMode == EvaluationMode::NNUE && NNUE::isLoaded()) {
+        int32_t eval = NNUE::evaluate(board.getAccumulator(), currentColour);
+        return static_cast<int16_t>(std::clamp<int32_t>(eval, -MAX_NNUE_EVALUATION, MAX_NNUE_EVALUATION));
+    }
+
     Colour opposingColour = (currentColour == Colour::WHITE) ? Colour::BLACK : Colour::WHITE;
     int16_t phase = gamePhase(board);
-    int16_t eval = pieceValueEvaluation(board, currentColour, phase) - pieceValueEvaluation(board, opposingColour, phase);
+    const PawnHashEntry& pawnEntry = probePawnStructure(board, game.getPawnHash());
+    EvaluationContext context;
+    buildEvaluationContext(board, context);
+    Score score = pieceValueEvaluation(board, currentColour, pawnEntry, context) - 
+                  pieceValueEvaluation(board, opposingColour, pawnEntry, context);
 
-    return eval;
+    return static_cast<int16_t>(score.interpolate(phase, MAX_PHASE));
+}
+
+void Evaluation::setEvaluationMode(EvaluationMode mode) {
+    evaluationMode = mode;
+    evalCache.clear();
+}
+
+void Evaluation::clearEvaluationCaches() {
+    evalCache.clear();
+    pawnHashTable.clear();
 }
 
 void Evaluation::addKillerMove(Move move, uint8_t ply) {
@@ -404,30 +650,56 @@ bool Evaluation::isKillerMove(Move move, uint8_t ply) {
     return (killerMoves[ply][0] == move || killerMoves[ply][1] == move);
 }
 
-void Evaluation::addHistoryHeuristic(Move move, Piece piece, Colour colour, uint8_t depth) {
-    uint8_t c = toIndex(colour);
-    uint8_t p = toIndex(piece);
-    int16_t& entry = historyHeuristics[c][p][move.getFromSquare()][move.getToSquare()];
-    entry += depth * depth;
+void Evaluation::updateHistory(Move move, Piece piece, Colour colour, const PreviousMoves& previousMoves, int depth, bool causedCutoff) {
+    const int update = historyUpdate(depth, causedCutoff);
+    const uint8_t c = toIndex(colour);
+    const uint8_t p = toIndex(piece);
+    const uint8_t toSquare = move.getToSquare();
+    applyHistoryGravity(historyHeuristics[c][p][move.getFromSquare()][toSquare], update);
+
+    for (uint8_t i = 0; i < 2; i++) {
+        if (previousMoves[i].piece == Piece::NONE) continue;
+        applyHistoryGravity(continuationHistory[c][i][toIndex(previousMoves[i].piece)][previousMoves[i].toSquare][p][toSquare], update);
+    }
+}
 
-    if (entry > MAX_HISTORY_VALUE) entry = MAX_HISTORY_VALUE;
+void Evaluation::updateCaptureHistory(Move move, Piece piece, Colour colour, int depth, bool causedCutoff) {
+    applyHistoryGravity(captureHistory[toIndex(colour)][toIndex(piece)][move.getToSquare()][move.getCapturedPiece()],
+                        historyUpdate(depth, causedCutoff));
+}
+
+void Evaluation::updateCorrectionHistory(Colour colour, uint64_t pawnHash, int depth, int16_t searchEval, int16_t staticEval) {
+    int16_t& entry = pawnCorrectionHistory[toIndex(colour)][pawnHash & (CORRECTION_HISTORY_SIZE - 1)];
+    // The error is clamped so that a single tactical score cannot saturate an entry meant to learn a positional bias
+    const int error = std::clamp((searchEval - staticEval) * CORRECTION_HISTORY_GRAIN,
+                                 -MAX_CORRECTION_HISTORY_VALUE / 2, MAX_CORRECTION_HISTORY_VALUE / 2);
+    const int weight = std::min(depth + 1, MAX_CORRECTION_HISTORY_WEIGHT);
+
+    // Moving average of the error, weighted towards deeper and so more reliable searches
+    const int updated = (entry * (CORRECTION_HISTORY_WEIGHT_SCALE - weight) + error * weight) / CORRECTION_HISTORY_WEIGHT_SCALE;
+    entry = static_cast<int16_t>(std::clamp(updated, -MAX_CORRECTION_HISTORY_VALUE, MAX_CORRECTION_HISTORY_VALUE));
 }
 
 void Evaluation::ageHistoryHeuristicsTable() {
-    for (uint8_t colour = 0; colour < 2; colour++) {
-        for (uint8_t piece = 0; piece < 6; piece++) {
-            for (uint8_t from = 0; from < 64; from++) {
-                for (uint8_t to = 0; to < 64; to++) {
-                    int16_t& entry = historyHeuristics[colour][piece][from][to];
-                    entry = 3 * entry / 4;
-                }
-            }
-        }
+    for (int16_t& entry : std::span(&historyHeuristics[0][0][0][0], sizeof(historyHeuristics) / sizeof(int16_t))) {
+        entry = 3 * entry / 4;
+    }
+
+    for (int16_t& entry : std::span(&continuationHistory[0][0][0][0][0][0], sizeof(continuationHistory) / sizeof(int16_t))) {
+        entry = 3 * entry / 4;
+    }
+
+    for (int16_t& entry : std::span(&captureHistory[0][0][0][0], sizeof(captureHistory) / sizeof(int16_t))) {
+        entry = 3 * entry / 4;
     }
 }
 
 void Evaluation::clearHistoryHeuristicsTable() {
     std::memset(historyHeuristics, 0, sizeof(historyHeuristics));
+    std::memset(continuationHistory, 0, sizeof(continuationHistory));
+    std::memset(captureHistory, 0, sizeof(captureHistory));
+    std::memset(pawnCorrectionHistory, 0, sizeof(pawnCorrectionHistory));
+    std::fill(&counterMoves[0][0][0], &counterMoves[0][0][0] + sizeof(counterMoves) / sizeof(Move), Move());
 }
 
 std::pair<MoveType, int16_t> Evaluation::orderingScore(const Move move, Board& board, uint8_t ply, Colour colour, const Move* bestMove) {
@@ -444,7 +716,8 @@ std::pair<MoveType, int16_t> Evaluation::orderingScore(const Move move, Board& b
         // Bonus for promotion capture
         if (capturedPiece != Move::NO_CAPTURE) {
             Piece attacker = board.getPiece(move.getFromSquare());
-            promotionScore += 10 * pieceEvals[capturedPiece] - pieceEvals[toIndex(attacker)];
+            promotionScore += 10 * pieceEvals[capturedPiece] - pieceEvals[toIndex(attacker)] +
+                              captureHistory[toIndex(colour)][toIndex(attacker)][move.getToSquare()][capturedPiece] / CAPTURE_HISTORY_DIVISOR;
         }
 
         return {MoveType::PROMOTION, promotionScore};
@@ -455,7 +728,8 @@ std::pair<MoveType, int16_t> Evaluation::orderingScore(const Move move, Board& b
     if (capturedPiece != Move::NO_CAPTURE) {
         int16_t captureScore = 0;
         Piece attacker = board.getPiece(move.getFromSquare());
-        captureScore += 10 * pieceEvals[capturedPiece] - pieceEvals[toIndex(attacker)];
+        captureScore += 10 * pieceEvals[capturedPiece] - pieceEvals[toIndex(attacker)] +
+                        captureHistory[toIndex(colour)][toIndex(attacker)][move.getToSquare()][capturedPiece] / CAPTURE_HISTORY_DIVISOR;
         return {MoveType::CAPTURE, captureScore};
     }
 
@@ -468,12 +742,13 @@ std::pair<MoveType, int16_t> Evaluation::orderingScore(const Move move, Board& b
     return {MoveType::HISTORY, historyScore};
 }
 
-int16_t Evaluation::orderingQuiescenceScore(const Move move, Board& board) {
-    int16_t score = 0;
+int32_t Evaluation::captureOrderingScore(const Move move, Board& board) {
+    int32_t score = 0;
     uint8_t capturedPiece = move.getCapturedPiece();
     if (capturedPiece != Move::NO_CAPTURE) {
-        Piece attacker = board.getPiece(move.getFromSquare());
-        score += 10 * pieceEvals[capturedPiece] - pieceEvals[toIndex(attacker)];
+        auto [attacker, colour] = board.getPieceAndColour(move.getFromSquare());
+        score += 10 * pieceEvals[capturedPiece] - pieceEvals[toIndex(attacker)] +
+                 captureHistory[toIndex(colour)][toIndex(attacker)][move.getToSquare()][capturedPiece] / CAPTURE_HISTORY_DIVISOR;
     }
 
     uint8_t promotionPiece = move.getPromotionPiece();
@@ -0,0 +1,238 @@
+#include <cstdint>
+#include <cstddef>
+#include <cassert>
+#include <utility>
+#include <vector>
+#include "engine/move_picker.h"
+#include "engine/evaluation.h"
+#include "move/move_generator.h"
+#include "board/board.h"
+#include "move/move.h"
+#include "chess_types.h"
+
+using Piece = Chess::PieceType;
+using Colour = Chess::PieceColour;
+using Chess::toIndex;
+
+MovePicker::MovePicker(Board& board, Colour colour, Move ttMove, uint8_t ply, const PreviousMoves& previousMoves, std::vector<Move>& moves) :
+    board(board),
+    colour(colour),
+    ttMove(ttMove),
+    killerMoves{Evaluation::getKillerMove(ply, 0), Evaluation::getKillerMove(ply, 1)},
+    counterMove(Evaluation::getCounterMove(colour, previousMoves[0])),
+    previousMoves(previousMoves),
+    quiescence(false),
+    evasions(false),
+    quietChecks(false),
+    moves(moves) {
+
+    moves.clear();
+}
+
+MovePicker::MovePicker(Board& board, Colour colour, Move ttMove, std::vector<Move>& moves, bool inCheck, bool quietChecks) :
+    board(board),
+    colour(colour),
+    ttMove(ttMove),
+    killerMoves{Move(), Move()},
+    counterMove(),
+    previousMoves(),
+    quiescence(true),
+    evasions(inCheck),
+    quietChecks(quietChecks),
+    moves(moves) {
+
+    moves.clear();
+}
+
+Move MovePicker::nextMove() {
+    switch (stage) {
+        case MovePickerStage::TT_MOVE:
+            stage = evasions ? MovePickerStage::GENERATE_EVASIONS : MovePickerStage::GENERATE_CAPTURES;
+            if (MoveGenerator::isPseudoLegal(board, colour, ttMove)) {
+                // Quiescence search skips losing moves in every later stage, so a losing transposition table move is skipped too
+                if (!quiescence || evasions || ttMove.getPromotionPiece() != Move::NO_PROMOTION ||
+                    Evaluation::staticExchangeAtLeast(board, ttMove)) {
+                    return ttMove;
+                }
+            }
+            if (evasions) return nextMove();
+            [[fallthrough]];
+
+        case MovePickerStage::GENERATE_CAPTURES: {
+            MoveGenerator::pseudoLegalCaptures(board, colour, moves);
+
+            // Only quiet queen promotions as capture promotions have already been generated
+            std::size_t promotionsStart = moves.size();
+            MoveGenerator::pseudoLegalQueenPromotions(board, colour, moves);
+            std::size_t end = promotionsStart;
+            for (std::size_t i = promotionsStart; i < moves.size(); i++) {
+                if (moves[i].getCapturedPiece() == Move::NO_CAPTURE) moves[end++] = moves[i];
+            }
+            moves.resize(end);
+
+            scoreCaptures();
+            stage = MovePickerStage::CAPTURES;
+            [[fallthrough]];
+        }
+
+        case MovePickerStage::CAPTURES:
+            while (current < moves.size()) {
+                Move move = selectBest();
+                if (move == ttMove) continue;
+
+                // Losing captures are kept in the slots of moves already yielded to be searched after the quiet moves
+                if (move.getPromotionPiece() == Move::NO_PROMOTION && !Evaluation::staticExchangeAtLeast(board, move)) {
+                    moves[badCapturesEnd++] = move;
+                    continue;
+                }
+
+                return move;
+            }
+
+            if (quiescence) {
+                stage = quietChecks ? MovePickerStage::GENERATE_QUIET_CHECKS : MovePickerStage::DONE;
+            } else {
+                stage = MovePickerStage::KILLERS;
+            }
+            return nextMove();
+
+        case MovePickerStage::KILLERS:
+            if (skipQuietMoves) {
+                stage = MovePickerStage::BAD_CAPTURES;
+                return nextMove();
+            }
+
+            // Killer moves come from sibling positions so they are yielded before quiet moves are generated
+            while (killerIndex < 2) {
+                Move killerMove = killerMoves[killerIndex++];
+                // Killer moves are quiet so they are not pseudo legal if their target square has since been occupied
+                if (killerMove != ttMove && MoveGenerator::isPseudoLegal(board, colour, killerMove)) return killerMove;
+            }
+
+            stage = MovePickerStage::COUNTER_MOVE;
+            [[fallthrough]];
+
+        case MovePickerStage::COUNTER_MOVE:
+            stage = MovePickerStage::GENERATE_QUIETS;
+            if (!skipQuietMoves && counterMove != ttMove && counterMove != killerMoves[0] && counterMove != killerMoves[1] &&
+                MoveGenerator::isPseudoLegal(board, colour, counterMove)) {
+                return counterMove;
+            }
+            [[fallthrough]];
+
+        case MovePickerStage::GENERATE_QUIETS: {
+            if (skipQuietMoves) {
+                stage = MovePickerStage::BAD_CAPTURES;
+                return nextMove();
+            }
+
+            std::size_t quietsStart = moves.size();
+            MoveGenerator::pseudoLegalQuiets(board, colour, moves);
+
+            // Quiet queen promotions were yielded with the captures and killer and counter moves were yielded before
+            std::size_t end = quietsStart;
+            for (std::size_t i = quietsStart; i < moves.size(); i++) {
+                const Move move = moves[i];
+                if (move.getPromotionPiece() != toIndex(Piece::QUEEN) && move != killerMoves[0] && move != killerMoves[1] &&
+                    move != counterMove) {
+                    moves[end++] = move;
+                }
+            }
+            moves.resize(end);
+
+            scoreQuiets();
+            stage = MovePickerStage::QUIETS;
+            [[fallthrough]];
+        }
+
+        case MovePickerStage::QUIETS:
+            while (current < moves.size() && !skipQuietMoves) {
+                Move move = selectBest();
+                if (move != ttMove) return move;
+            }
+
+            stage = MovePickerStage::BAD_CAPTURES;
+            [[fallthrough]];
+
+        case MovePickerStage::BAD_CAPTURES:
+            if (badCaptureIndex < badCapturesEnd) return moves[badCaptureIndex++];
+
+            stage = MovePickerStage::DONE;
+            return Move();
+
+        case MovePickerStage::GENERATE_QUIET_CHECKS: {
+            Colour opposingColour = (colour == Colour::WHITE) ? Colour::BLACK : Colour::WHITE;
+            MoveGenerator::pseudoLegalNonCaptureChecks(board, colour, board.getKingSquare(opposingColour), moves);
+            stage = MovePickerStage::QUIET_CHECKS;
+            [[fallthrough]];
+        }
+
+        case MovePickerStage::QUIET_CHECKS:
+            // Quiet checks are left in generation order, checks which lose the moved piece are skipped
+            while (current < moves.size()) {
+                Move move = moves[current++];
+                if (move != ttMove && Evaluation::staticExchangeAtLeast(board, move)) return move;
+            }
+
+            stage = MovePickerStage::DONE;
+            return Move();
+
+        case MovePickerStage::GENERATE_EVASIONS:
+            MoveGenerator::pseudoLegalEvasions(board, colour, moves);
+            scoreEvasions();
+            stage = MovePickerStage::EVASIONS;
+            [[fallthrough]];
+
+        case MovePickerStage::EVASIONS:
+            while (current < moves.size()) {
+                Move move = selectBest();
+                if (move != ttMove) return move;
+            }
+
+            stage = MovePickerStage::DONE;
+            return Move();
+
+        case MovePickerStage::DONE:
+            return Move();
+    }
+
+    return Move();
+}
+
+Move MovePicker::selectBest() {
+    std::size_t best = current;
+    for (std::size_t i = current + 1; i < moves.size(); i++) {
+        if (scores[i] > scores[best]) best = i;
+    }
+
+    std::swap(moves[current], moves[best]);
+    std::swap(scores[current], scores[best]);
+    return moves[current++];
+}
+
+void MovePicker::scoreCaptures() {
+    assert(moves.size() <= MAX_MOVES && "Too many moves generated");
+    for (std::size_t i = current; i < moves.size(); i++) {
+        scores[i] = Evaluation::captureOrderingScore(moves[i], board);
+    }
+}
+
+void MovePicker::scoreQuiets() {
+    assert(moves.size() <= MAX_MOVES && "Too many moves generated");
+    for (std::size_t i = current; i < moves.size(); i++) {
+        const Move move = moves[i];
+        scores[i] = Evaluation::historyOrderingScore(move, board.getPiece(move.getFromSquare()), colour, previousMoves);
+    }
+}
+
+void MovePicker::scoreEvasions() {
+    assert(moves.size() <= MAX_MOVES && "Too many moves generated");
+    for (std::size_t i = current; i < moves.size(); i++) {
+        const Move move = moves[i];
+        if (move.getCapturedPiece() != Move::NO_CAPTURE) {
+            scores[i] = EVASION_CAPTURE_BONUS + Evaluation::captureOrderingScore(move, board);
+        } else {
+            scores[i] = Evaluation::historyOrderingScore(move, board.getPiece(move.getFromSquare()), colour, previousMoves);
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,196 @@
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <fstream>
+#include <vector>
+#include <algorithm>
+#include "engine/nnue.h"
+#include "engine/evaluation.h"
+#include "chess_types.h"
+
+#if defined(__AVX2__) || defined(__SSE4_1__)
+#include <immintrin.h>
+#endif
+
+using Piece = Chess::PieceType;
+using Colour = Chess::PieceColour;
+using Chess::toIndex;
+
+namespace {
+    constexpr std::size_t HIDDEN_SIZE = NNUE::HIDDEN_SIZE;
+
+    struct Network {
+        alignas(32) int16_t featureWeights[NNUE::INPUT_SIZE][HIDDEN_SIZE];
+        alignas(32) int16_t featureBiases[HIDDEN_SIZE];
+        alignas(32) int16_t outputWeights[2 * HIDDEN_SIZE];
+        int16_t outputBias;
+    };
+
+    Network network;
+
+    /**
+     * @brief Gets the input index of a piece from the perspective of a colour
+     * @note Pieces belonging to the perspective colour come first and black's perspective is mirrored vertically
+     * so that both perspectives share the same weights
+     */
+    inline std::size_t featureIndex(Colour perspective, Piece piece, Colour colour, uint8_t square) {
+        const std::size_t relativeColour = (colour == perspective) ? 0 : 1;
+        const uint8_t relativeSquare = (perspective == Colour::WHITE) ? square : square ^ 0x38;
+        return relativeColour * 384 + toIndex(piece) * 64 + relativeSquare;
+    }
+
+    inline void addRow(int16_t* accumulator, const int16_t* row) {
+#if defined(__AVX2__)
+        for (std::size_t i = 0; i < HIDDEN_SIZE; i += 16) {
+            __m256i values = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(accumulator + i));
+            __m256i weights = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(row + i));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(accumulator + i), _mm256_add_epi16(values, weights));
+        }
+#elif defined(__SSE4_1__)
+        for (std::size_t i = 0; i < HIDDEN_SIZE; i += 8) {
+            __m128i values = _mm_loadu_si128(reinterpret_cast<const __m128i*>(accumulator + i));
+            __m128i weights = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row + i));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(accumulator + i), _mm_add_epi16(values, weights));
+        }
+#else
+        for (std::size_t i = 0; i < HIDDEN_SIZE; i++) {
+            accumulator[i] += row[i];
+        }
+#endif
+    }
+
+    inline void subtractRow(int16_t* accumulator, const int16_t* row) {
+#if defined(__AVX2__)
+        for (std::size_t i = 0; i < HIDDEN_SIZE; i += 16) {
+            __m256i values = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(accumulator + i));
+            __m256i weights = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(row + i));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(accumulator + i), _mm256_sub_epi16(values, weights));
+        }
+#elif defined(__SSE4_1__)
+        for (std::size_t i = 0; i < HIDDEN_SIZE; i += 8) {
+            __m128i values = _mm_loadu_si128(reinterpret_cast<const __m128i*>(accumulator + i));
+            __m128i weights = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row + i));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(accumulator + i), _mm_sub_epi16(values, weights));
+        }
+#else
+        for (std::size_t i = 0; i < HIDDEN_SIZE; i++) {
+            accumulator[i] -= row[i];
+        }
+#endif
+    }
+
+    /**
+     * @brief Computes the dot product of the clipped ReLU of the accumulator with the output weights
+     */
+    inline int32_t clippedDotProduct(const int16_t* accumulator, const int16_t* weights) {
+#if defined(__AVX2__)
+        const __m256i zero = _mm256_setzero_si256();
+        const __m256i max = _mm256_set1_epi16(NNUE::QA);
+        __m256i sum = _mm256_setzero_si256();
+
+        for (std::size_t i = 0; i < HIDDEN_SIZE; i += 16) {
+            __m256i values = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(accumulator + i));
+            __m256i outputWeights = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(weights + i));
+            values = _mm256_min_epi16(_mm256_max_epi16(values, zero), max);
+            sum = _mm256_add_epi32(sum, _mm256_madd_epi16(values, outputWeights));
+        }
+
+        __m128i sum128 = _mm_add_epi32(_mm256_castsi256_si128(sum), _mm256_extracti128_si256(sum, 1));
+        sum128 = _mm_add_epi32(sum128, _mm_shuffle_epi32(sum128, _MM_SHUFFLE(1, 0, 3, 2)));
+        sum128 = _mm_add_epi32(sum128, _mm_shuffle_epi32(sum128, _MM_SHUFFLE(2, 3, 0, 1)));
+        return _mm_cvtsi128_si32(sum128);
+#elif defined(__SSE4_1__)
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i max = _mm_set1_epi16(NNUE::QA);
+        __m128i sum = _mm_setzero_si128();
+
+        for (std::size_t i = 0; i < HIDDEN_SIZE; i += 8) {
+            __m128i values = _mm_loadu_si128(reinterpret_cast<const __m128i*>(accumulator + i));
+            __m128i outputWeights = _mm_loadu_si128(reinterpret_cast<const __m128i*>(weights + i));
+            values = _mm_min_epi16(_mm_max_epi16(values, zero), max);
+            sum = _mm_add_epi32(sum, _mm_madd_epi16(values, outputWeights));
+        }
+
+        sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(1, 0, 3, 2)));
+        sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(2, 3, 0, 1)));
+        return _mm_cvtsi128_si32(sum);
+#else
+        int32_t sum = 0;
+        for (std::size_t i = 0; i < HIDDEN_SIZE; i++) {
+            int32_t value = std::clamp<int32_t>(accumulator[i], 0, NNUE::QA);
+            sum += value * weights[i];
+        }
+        return sum;
+#endif
+    }
+}
+
+bool NNUE::load(const std::string& path) {
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file) return false;
+
+    constexpr std::size_t parameterCount = INPUT_SIZE * HIDDEN_SIZE + HIDDEN_SIZE + 2 * HIDDEN_SIZE + 1;
+    if (static_cast<std::size_t>(file.tellg()) != parameterCount * sizeof(int16_t)) return false;
+    file.seekg(0);
+
+    std::vector<uint8_t> bytes(parameterCount * sizeof(int16_t));
+    if (!file.read(reinterpret_cast<char*>(bytes.data()), bytes.size())) return false;
+
+    // Decode as little endian regardless of the host byte order
+    std::size_t offset = 0;
+    auto next = [&bytes, &offset]() {
+        int16_t value = static_cast<int16_t>(bytes[offset] | (bytes[offset + 1] << 8));
+        offset += 2;
+        return value;
+    };
+
+    for (std::size_t input = 0; input < INPUT_SIZE; input++) {
+        for (std::size_t i = 0; i < HIDDEN_SIZE; i++) {
+            network.featureWeights[input][i] = next();
+        }
+    }
+    for (std::size_t i = 0; i < HIDDEN_SIZE; i++) network.featureBiases[i] = next();
+    for (std::size_t i = 0; i < 2 * HIDDEN_SIZE; i++) network.outputWeights[i] = next();
+    network.outputBias = next();
+
+    networkId++;
+    // Cached evaluations were scored by the previous network
+    Evaluation::clearEvaluationCaches();
+    return true;
+}
+
+void NNUE::resetAccumulator(NNUEAccumulator& accumulator) {
+    std::copy(std::begin(network.featureBiases), std::end(network.featureBiases), accumulator.values[0]);
+    std::copy(std::begin(network.featureBiases), std::end(network.featureBiases), accumulator.values[1]);
+}
+
+void NNUE::addFeature(NNUEAccumulator& accumulator, Piece piece, Colour colour, uint8_t square) {
+    addRow(accumulator.values[toIndex(Colour::WHITE)], network.featureWeights[featureIndex(Colour::WHITE, piece, colour, square)]);
+    addRow(accumulator.values[toIndex(Colour::BLACK)], network.featureWeights[featureIndex(Colour::BLACK, piece, colour, square)]);
+}
+
+void NNUE::removeFeature(NNUEAccumulator& accumulator, Piece piece, Colour colour, uint8_t square) {
+    subtractRow(accumulator.values[toIndex(Colour::WHITE)], network.featureWeights[featureIndex(Colour::WHITE, piece, colour, square)]);
+    subtractRow(accumulator.values[toIndex(Colour::BLACK)], network.featureWeights[featureIndex(Colour::BLACK, piece, colour, square)]);
+}
+
+int32_t NNUE::evaluate(const NNUEAccumulator& accumulator, Colour colour) {
+    const Colour opposingColour = (colour == Colour::WHITE) ? Colour::BLACK : Colour::WHITE;
+
+    int32_t output = clippedDotProduct(accumulator.values[toIndex(colour)], network.outputWeights) +
+                     clippedDotProduct(accumulator.values[toIndex(opposingColour)], network.outputWeights + HIDDEN_SIZE);
+
+    output /= QA;
+    output += network.outputBias;
+    return output * OUTPUT_SCALE / (QA * QB);
+}
+
+const char* NNUE::getKernelName() {
+#if defined(__AVX2__)
+    return "AVX2";
+#elif defined(__SSE4_1__)
+    return "SSE4.1";
+#else
+    return "Scalar";
+#endif
+}
\ No newline at end of file
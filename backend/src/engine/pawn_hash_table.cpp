@@ -0,0 +1,39 @@
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+#include <bit>
+#include "engine/pawn_hash_table.h"
+
+PawnHashTable::PawnHashTable(std::size_t size) :
+               TABLE_SIZE(std::bit_floor(size * 1024 * 1024 / sizeof(PawnHashEntry))) {
+
+    table.resize(TABLE_SIZE);
+    clear();
+}
+
+PawnHashEntry& PawnHashTable::add(uint64_t key, const PawnHashEntry& entry) {
+    PawnHashEntry& slot = table[key & (TABLE_SIZE - 1)];
+    slot = entry;
+    slot.pawnKey = key;
+    slot.occupied = true;
+
+    return slot;
+}
+
+PawnHashEntry* PawnHashTable::getEntry(uint64_t key) {
+    probes++;
+    PawnHashEntry& slot = table[key & (TABLE_SIZE - 1)];
+
+    if (slot.occupied && slot.pawnKey == key) {
+        hits++;
+        return &slot;
+    }
+
+    return nullptr;
+}
+
+void PawnHashTable::clear() {
+    std::fill(table.begin(), table.end(), PawnHashEntry{});
+    probes = 0;
+    hits = 0;
+}
\ No newline at end of file
@@ -2,6 +2,7 @@
 #include <cstddef>
 #include <cassert>
 #include <climits>
+#include <limits>
 #include <algorithm>
 #include <bit>
 #include "engine/transposition_table.h"
@@ -23,6 +24,25 @@ TranspositionTable::TranspositionTable(std::size_t size) :
 void TranspositionTable::add(uint64_t key, const TTEntry& newEntry) {
     TTBucket& bucket = table[key & (TT_SIZE - 1)];
 
+    // Update an existing entry of the same position so that a key never occupies both slots,
+    // otherwise the older entry in the first slot would hide the newer one from getEntry and getBestMove
+    for (uint8_t i = 0; i < TTBucket::BUCKET_SIZE; i++) {
+        TTEntry& entry = bucket.entries[i];
+        if (entry.zobristKey != key) continue;
+
+        // Shallow entries, such as quiescence entries of a negamax position, do not replace a deeper bound
+        if (newEntry.flag != TTFlag::EXACT && newEntry.generation <= entry.generation &&
+            newEntry.depth < entry.depth - SAME_KEY_DEPTH_MARGIN) {
+            return;
+        }
+
+        // Fail lows and stand pats have no best move, so the move of the previous search is kept for ordering
+        const Move bestMove = (newEntry.bestMove == Move()) ? entry.bestMove : newEntry.bestMove;
+        entry = newEntry;
+        entry.bestMove = bestMove;
+        return;
+    }
+
     uint8_t replaceIndex = 0;
     int minScore = std::numeric_limits<int>::max();
 
@@ -36,7 +56,7 @@ void TranspositionTable::add(uint64_t key, const TTEntry& newEntry) {
         }
 
         int16_t score = 0;
-        score += entry.depth << 8;
+        score += entry.depth * 256;
         if (entry.flag == TTFlag::EXACT) score += 128;
 
         if (score < minScore) {
@@ -61,6 +81,16 @@ TTEntry* TranspositionTable::getEntry(uint64_t key) {
     return nullptr;
 }
 
+Move TranspositionTable::getBestMove(uint64_t key) const {
+    const TTBucket& bucket = table[key & (TT_SIZE - 1)];
+
+    for (uint8_t i = 0; i < TTBucket::BUCKET_SIZE; i++) {
+        if (bucket.entries[i].zobristKey == key) return bucket.entries[i].bestMove;
+    }
+
+    return Move();
+}
+
 void TranspositionTable::clear() {
     std::fill(table.begin(), table.end(), TTBucket{});
 }
\ No newline at end of file
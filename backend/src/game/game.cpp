@@ -73,9 +73,12 @@ namespace {
 
 Game::Game() : currentTurn(Colour::WHITE) {
     uint64_t hash = Zobrist::computeInitialHash(board, currentTurn);
+    uint64_t pawnHash = Zobrist::computeInitialPawnHash(board);
+    positionHistory.clear();
+    irreversiblePositionIndices.clear();
     positionHistory.push_back(hash);
     irreversiblePositionIndices.push_back(0);
-    GameState currentState = createGameState(currentTurn, board.getEnPassantSquare(), board.getCastlingRights(), 0, 1, hash);
+    GameState currentState = createGameState(currentTurn, board.getEnPassantSquare(), board.getCastlingRights(), 0, 1, hash, pawnHash);
     gameStateHistory.push(currentState);
 }
 
@@ -113,9 +116,10 @@ void Game::makeMove(const Move move) {
     auto newCastlingRights = board.getCastlingRights();
     uint64_t newHash = Zobrist::updateHash(currentState.hash, move, currentState.enPassantSquare, newEnPassantSquare,
                                             currentState.castleRights, newCastlingRights, colour, piece);
+    uint64_t newPawnHash = Zobrist::updatePawnHash(currentState.pawnHash, move, currentState.enPassantSquare, colour, piece);
 
     if (isIrreversibleMove(piece, move)) irreversiblePositionIndices.push_back(positionHistory.size());
-    GameState newState = createGameState(newPlayerTurn, newEnPassantSquare, newCastlingRights, newHalfMoves, newFullMoves, newHash);    
+    GameState newState = createGameState(newPlayerTurn, newEnPassantSquare, newCastlingRights, newHalfMoves, newFullMoves, newHash, newPawnHash);
     positionHistory.push_back(newHash);
     moveHistory.push(move);
     gameStateHistory.push(newState);
@@ -271,7 +275,8 @@ void Game::makeNullMove() {
     board.setEnPassantSquare(newEnPassantSquare);
     uint64_t newHash = Zobrist::updateNullMoveHash(currentState.hash, currentState.enPassantSquare);
 
-    GameState newState = createGameState(newPlayerTurn, newEnPassantSquare, currentState.castleRights, newHalfMoves, newFullMoves, newHash);
+    GameState newState = createGameState(newPlayerTurn, newEnPassantSquare, currentState.castleRights, newHalfMoves, 
+                                        newFullMoves, newHash, currentState.pawnHash);
     positionHistory.push_back(newHash);
     gameStateHistory.push(newState);
     currentTurn = newPlayerTurn;
@@ -295,41 +300,42 @@ bool Game::isIrreversibleMove(Piece piece, Move move) {
     );
 }
 
-// // TESTING PURPOSES ONLY
-// void Game::setCustomGameState(const char* fen) {
-//     board.setCustomBoardState(fen);
-//     int index = 0;
-//     while (fen[index++] != ' ');
-//     index++;
-
-//     currentTurn = (fen[index] == 'w') ? Colour::WHITE : Colour::BLACK;
-
-//     // Jump to half move clock
-//     index += 2;
-//     while (fen[index++] != ' ');
-//     index++;
-//     while(fen[index++] != ' ');
-//     index++;
-
-//     uint8_t halfMoveClock = 0;
-//     while (fen[index] != ' ') {
-//         halfMoveClock = 10 * halfMoveClock + (fen[index] - '0');
-//         index++;
-//     }
-//     index++;
-
-//     uint16_t fullMoves = 0;
-//     while (fen[index]) {
-//         fullMoves = 10 * fullMoves + (fen[index] - '0');
-//         index++;
-//     }
-
-//     positionHistory.pop_back();
-//     gameStateHistory.pop();
-
-//     uint64_t hash = Zobrist::computeInitialHash(board, currentTurn);
-//     positionHistory.push_back(hash);
-//     GameState currentState = createGameState(currentTurn, board.getEnPassantSquare(), 
-//                                             board.getCastlingRights(), halfMoveClock, fullMoves, hash);
-//     gameStateHistory.push(currentState);
-// }
\ No newline at end of file
+// TESTING PURPOSES ONLY
+void Game::setCustomGameState(const char* fen) {
+    board.setCustomBoardState(fen);
+    int index = 0;
+    while (fen[index++] != ' '); // Jump to player turn
+
+    currentTurn = (fen[index] == 'w') ? Colour::WHITE : Colour::BLACK;
+
+    // Jump past castling rights and en passant square to half move clock
+    index += 2;
+    while (fen[index++] != ' ');
+    while (fen[index++] != ' ');
+
+    uint8_t halfMoveClock = 0;
+    while (fen[index] != ' ') {
+        halfMoveClock = 10 * halfMoveClock + (fen[index] - '0');
+        index++;
+    }
+    index++;
+
+    uint16_t fullMoves = 0;
+    while (fen[index]) {
+        fullMoves = 10 * fullMoves + (fen[index] - '0');
+        index++;
+    }
+
+    while (!gameStateHistory.empty()) gameStateHistory.pop();
+    while (!moveHistory.empty()) moveHistory.pop();
+    positionHistory.clear();
+    irreversiblePositionIndices.clear();
+
+    uint64_t hash = Zobrist::computeInitialHash(board, currentTurn);
+    uint64_t pawnHash = Zobrist::computeInitialPawnHash(board);
+    positionHistory.push_back(hash);
+    irreversiblePositionIndices.push_back(0);
+    GameState currentState = createGameState(currentTurn, board.getEnPassantSquare(), 
+                                            board.getCastlingRights(), halfMoveClock, fullMoves, hash, pawnHash);
+    gameStateHistory.push(currentState);
+}
\ No newline at end of file
@@ -2,6 +2,7 @@
 #include <array>
 #include <optional>
 #include <cstdint>
+#include <cstddef>
 #include <bit>
 #include <cassert>
 #include "board/board.h"
@@ -54,6 +55,27 @@ namespace {
         }
     }
 
+    /**
+     * @brief Generates pseudo legal moves which are not captures using a precomputed table of moves
+     * @param board Board object representing current board state
+     * @param currSquare Square that the piece is located on (0-63)
+     * @param moves Vector to append moves to
+     * @param precomputedMoveBitboard Bitboard representation of possible moves for that piece (from table lookup)
+     * @warning This function does not take into account king safety
+     */
+    static void pseudoLegalQuietsFromTable(const Board& board, uint8_t currSquare,
+                                            std::vector<Move>& moves, Bitboard precomputedMoveBitboard) {
+
+        assert(currSquare < 64 && "currSquare must be between 0-63");
+        precomputedMoveBitboard &= ~board.getPiecesBitboard(); // Only moves which land onto empty squares
+
+        while (precomputedMoveBitboard) {
+            uint8_t bitIndex = std::countr_zero(precomputedMoveBitboard); // Square on board
+            moves.push_back(Move(currSquare, bitIndex));
+            precomputedMoveBitboard &= precomputedMoveBitboard - 1; // Remove trailing set bit
+        }
+    }
+
     /**
      * @brief Generates pseudo legal capture moves using a precomputed table of moves
      * @param board Board object representing current board state
@@ -217,6 +239,49 @@ void MoveGenerator::pseudoLegalCaptures(const Board& board, Colour colour, std::
     }
 }
 
+void MoveGenerator::pseudoLegalQuiets(const Board& board, Colour colour, std::vector<Move>& moves) {
+    const Bitboard allPiecesBitboard = board.getPiecesBitboard();
+
+    Bitboard pawnsBitboard = board.getBitboard(Piece::PAWN, colour);
+    while (pawnsBitboard) {
+        pseudoLegalPawnPushes(board, colour, std::countr_zero(pawnsBitboard), moves);
+        pawnsBitboard &= (pawnsBitboard - 1);
+    }
+
+    Bitboard knightsBitboard = board.getBitboard(Piece::KNIGHT, colour);
+    while (knightsBitboard) {
+        uint8_t square = std::countr_zero(knightsBitboard);
+        pseudoLegalQuietsFromTable(board, square, moves, PrecomputeMoves::knightMoveTable[square]);
+        knightsBitboard &= (knightsBitboard - 1);
+    }
+
+    Bitboard bishopsBitboard = board.getBitboard(Piece::BISHOP, colour);
+    while (bishopsBitboard) {
+        uint8_t square = std::countr_zero(bishopsBitboard);
+        pseudoLegalQuietsFromTable(board, square, moves, PrecomputeMoves::getBishopMovesFromTable(square, allPiecesBitboard));
+        bishopsBitboard &= (bishopsBitboard - 1);
+    }
+
+    Bitboard rooksBitboard = board.getBitboard(Piece::ROOK, colour);
+    while (rooksBitboard) {
+        uint8_t square = std::countr_zero(rooksBitboard);
+        pseudoLegalQuietsFromTable(board, square, moves, PrecomputeMoves::getRookMovesFromTable(square, allPiecesBitboard));
+        rooksBitboard &= (rooksBitboard - 1);
+    }
+
+    Bitboard queensBitboard = board.getBitboard(Piece::QUEEN, colour);
+    while (queensBitboard) {
+        uint8_t square = std::countr_zero(queensBitboard);
+        pseudoLegalQuietsFromTable(board, square, moves, PrecomputeMoves::getBishopMovesFromTable(square, allPiecesBitboard));
+        pseudoLegalQuietsFromTable(board, square, moves, PrecomputeMoves::getRookMovesFromTable(square, allPiecesBitboard));
+        queensBitboard &= (queensBitboard - 1);
+    }
+
+    uint8_t kingSquare = board.getKingSquare(colour);
+    pseudoLegalQuietsFromTable(board, kingSquare, moves, PrecomputeMoves::kingMoveTable[kingSquare]);
+    pseudoLegalCastlingMoves(board, colour, kingSquare, moves);
+}
+
 void MoveGenerator::pseudoLegalCaptures(const Board& board, Piece piece, Colour colour, uint8_t currSquare, std::vector<Move>& moves) {
     assert(currSquare < 64 && "currSquare must be between 0-63");
     switch (piece) {
@@ -309,9 +374,172 @@ void MoveGenerator::pseudoLegalNonCaptureChecks(const Board& board, Colour colou
     }
 }
 
+void MoveGenerator::pseudoLegalEvasions(const Board& board, Colour colour, std::vector<Move>& moves) {
+    const uint8_t kingSquare = board.getKingSquare(colour);
+    const Bitboard checkers = board.checkers(colour);
+    assert(checkers && "King must be in check");
+
+    // Castling is never legal in check
+    pseudoLegalMovesFromTable(board, colour, kingSquare, moves, PrecomputeMoves::kingMoveTable[kingSquare]);
+
+    // Only the king can move out of a double check
+    if (checkers & (checkers - 1)) return;
+
+    const uint8_t checkerSquare = std::countr_zero(checkers);
+    const Bitboard targets = checkers | PrecomputeMoves::squaresBetweenTable[kingSquare][checkerSquare];
+
+    constexpr Piece pieces[5] = {Piece::PAWN, Piece::KNIGHT, Piece::BISHOP, Piece::ROOK, Piece::QUEEN};
+    const std::size_t start = moves.size();
+    for (Piece piece : pieces) pseudoLegalMoves(board, piece, colour, moves);
+
+    // Keep the moves which capture the checker or block the check, en passant can only capture a checking pawn
+    std::size_t end = start;
+    for (std::size_t i = start; i < moves.size(); i++) {
+        const Move move = moves[i];
+        const bool capturesCheckerEnPassant = move.getEnPassant() &&
+                                              ((move.getFromSquare() & ~0x7) | (move.getToSquare() & 0x7)) == checkerSquare;
+        if (bitSet(targets, move.getToSquare()) || capturesCheckerEnPassant) moves[end++] = move;
+    }
+    moves.resize(end);
+}
+
+bool MoveGenerator::isPseudoLegal(const Board& board, Colour colour, Move move) {
+    if (move == Move()) return false;
+
+    const uint8_t fromSquare = move.getFromSquare();
+    const uint8_t toSquare = move.getToSquare();
+    if (!board.isSelfOccupied(colour, fromSquare) || board.isSelfOccupied(colour, toSquare)) return false;
+
+    const Piece piece = board.getPiece(fromSquare);
+    const uint8_t capturedPiece = move.getCapturedPiece();
+    const uint8_t promotionPiece = move.getPromotionPiece();
+    const uint8_t c = toIndex(colour);
+
+    if (move.getCastling() != Move::NO_CASTLE) {
+        if (piece != Piece::KING || capturedPiece != Move::NO_CAPTURE || 
+            promotionPiece != Move::NO_PROMOTION || move.getEnPassant()) return false;
+
+        if (move.getCastling() != toIndex(Castling::KINGSIDE) && move.getCastling() != toIndex(Castling::QUEENSIDE)) return false;
+        bool kingside = (move.getCastling() == toIndex(Castling::KINGSIDE));
+        if (toSquare != (kingside ? fromSquare + 2 : fromSquare - 2)) return false;
+        if (!board.getCastlingRights(colour, kingside ? Castling::KINGSIDE : Castling::QUEENSIDE)) return false;
+
+        uint64_t emptySquareMask;
+        if (kingside) emptySquareMask = (colour == Colour::WHITE) ? 0x60 : 0x6000000000000000;
+        else emptySquareMask = (colour == Colour::WHITE) ? 0xE : 0x0E00000000000000;
+        if (board.getPiecesBitboard() & emptySquareMask) return false;
+
+        uint8_t passingSquare = kingside ? fromSquare + 1 : fromSquare - 1;
+        return !Check::isInDanger(board, colour, passingSquare) && !Check::isInCheck(board, colour);
+    }
+
+    if (move.getEnPassant()) {
+        const std::optional<uint8_t> enPassantSquare = board.getEnPassantSquare();
+        if (piece != Piece::PAWN || capturedPiece != toIndex(Piece::PAWN) || 
+            promotionPiece != Move::NO_PROMOTION || !enPassantSquare.has_value()) return false;
+
+        int directions[2] = {1, -1};
+        return bitSet(PrecomputeMoves::enPassantSquareTable[c][fromSquare], *enPassantSquare) &&
+               toSquare == *enPassantSquare + 8 * directions[c];
+    }
+
+    // The captured piece flag must match the piece on the target square
+    uint8_t expectedCapture = board.isOpponentOccupied(colour, toSquare) ? toIndex(board.getPiece(toSquare)) : Move::NO_CAPTURE;
+    if (capturedPiece != expectedCapture) return false;
+
+    if (piece == Piece::PAWN) {
+        uint8_t promotionPawnRanks[2] = {6, 1};
+        bool promotes = (Board::getRank(fromSquare) == promotionPawnRanks[c]);
+        bool validPromotion = (promotionPiece >= toIndex(Piece::KNIGHT) && promotionPiece <= toIndex(Piece::QUEEN));
+        if (promotes != validPromotion || (!promotes && promotionPiece != Move::NO_PROMOTION)) return false;
+
+        if (capturedPiece != Move::NO_CAPTURE) {
+            return bitSet(PrecomputeMoves::pawnCaptureTable[c][fromSquare], toSquare);
+        }
+
+        Bitboard singlePawnPush = PrecomputeMoves::singlePawnPushTable[c][fromSquare];
+        if (singlePawnPush == (1ULL << toSquare)) return true; // Target square is known to be empty
+
+        Bitboard doublePawnPush = PrecomputeMoves::doublePawnPushTable[c][fromSquare];
+        return doublePawnPush == (1ULL << toSquare) && !(board.getPiecesBitboard() & singlePawnPush);
+    }
+
+    if (promotionPiece != Move::NO_PROMOTION) return false;
+
+    const Bitboard allPiecesBitboard = board.getPiecesBitboard();
+    Bitboard movesBitboard = 0ULL;
+    switch (piece) {
+        case Piece::KNIGHT:
+            movesBitboard = PrecomputeMoves::knightMoveTable[fromSquare];
+            break;
+        case Piece::BISHOP:
+            movesBitboard = PrecomputeMoves::getBishopMovesFromTable(fromSquare, allPiecesBitboard);
+            break;
+        case Piece::ROOK:
+            movesBitboard = PrecomputeMoves::getRookMovesFromTable(fromSquare, allPiecesBitboard);
+            break;
+        case Piece::QUEEN:
+            movesBitboard = PrecomputeMoves::getBishopMovesFromTable(fromSquare, allPiecesBitboard) |
+                            PrecomputeMoves::getRookMovesFromTable(fromSquare, allPiecesBitboard);
+            break;
+        case Piece::KING:
+            movesBitboard = PrecomputeMoves::kingMoveTable[fromSquare];
+            break;
+        default:
+            return false;
+    }
+
+    return bitSet(movesBitboard, toSquare);
+}
+
+bool MoveGenerator::isLegal(const Board& board, Colour colour, Move move) {
+    const uint8_t fromSquare = move.getFromSquare();
+    const uint8_t toSquare = move.getToSquare();
+    const uint8_t kingSquare = board.getKingSquare(colour);
+    const Bitboard allPiecesBitboard = board.getPiecesBitboard();
+
+    if (fromSquare == kingSquare) {
+        // Being in check and passing through an attacked square were ruled out when castling was generated
+        if (move.getCastling() != Move::NO_CASTLE) return !Check::isInDanger(board, colour, toSquare);
+
+        // The king must not stay on a ray that it is sliding away from
+        Bitboard occupiedAfterMove = allPiecesBitboard & ~(1ULL << fromSquare);
+        return !(board.attackersTo(toSquare, occupiedAfterMove) & board.getOpposingBitboard(colour));
+    }
+
+    if (move.getEnPassant()) {
+        // Both pawns leave the rank of the king at once so pins cannot be used
+        int directions[2] = {1, -1};
+        uint8_t capturedSquare = toSquare - 8 * directions[toIndex(colour)];
+        Bitboard occupiedAfterMove = (allPiecesBitboard & ~(1ULL << fromSquare) & ~(1ULL << capturedSquare)) | (1ULL << toSquare);
+        return !(board.attackersTo(kingSquare, occupiedAfterMove) & board.getOpposingBitboard(colour));
+    }
+
+    const Bitboard checkers = board.checkers(colour);
+    if (checkers) {
+        // Only the king can move out of a double check
+        if (checkers & (checkers - 1)) return false;
+
+        // The move must capture the checking piece or block its ray
+        uint8_t checkerSquare = std::countr_zero(checkers);
+        Bitboard evasionSquares = checkers | PrecomputeMoves::squaresBetweenTable[kingSquare][checkerSquare];
+        if (!bitSet(evasionSquares, toSquare)) return false;
+    }
+
+    // A pinned piece may only move along the line between its king and the pinning piece
+    return !bitSet(board.pinned(colour), fromSquare) || bitSet(PrecomputeMoves::lineTable[kingSquare][fromSquare], toSquare);
+}
+
 void MoveGenerator::pseudoLegalPawnMoves(const Board& board, Colour colour, 
                                         uint8_t currSquare, std::vector<Move>& moves) {
 
+    pseudoLegalPawnPushes(board, colour, currSquare, moves);
+    pseudoLegalPawnCaptures(board, colour, currSquare, moves);
+}
+
+void MoveGenerator::pseudoLegalPawnPushes(const Board& board, Colour colour, 
+                                        uint8_t currSquare, std::vector<Move>& moves) {
+
     uint8_t promotionPawnRanks[2] = {6, 1};
     uint8_t c = toIndex(colour);
     if (Board::getRank(currSquare) != promotionPawnRanks[c]) {
@@ -346,8 +574,6 @@ void MoveGenerator::pseudoLegalPawnMoves(const Board& board, Colour colour,
             moves.push_back(Move(currSquare, singlePawnPushSquare, Move::NO_CAPTURE, toIndex(Piece::QUEEN)));
         }
     }
-
-    pseudoLegalPawnCaptures(board, colour, currSquare, moves);
 }
 
 void MoveGenerator::pseudoLegalKnightMoves(const Board& board, Colour colour, 
@@ -381,7 +607,12 @@ void MoveGenerator::pseudoLegalKingMoves(const Board& board, Colour colour,
     // Regular moves
     pseudoLegalMovesFromTable(board, colour, currSquare, moves, PrecomputeMoves::kingMoveTable[currSquare]);
 
-    // Castling moves
+    pseudoLegalCastlingMoves(board, colour, currSquare, moves);
+}
+
+void MoveGenerator::pseudoLegalCastlingMoves(const Board& board, Colour colour, 
+                                            uint8_t currSquare, std::vector<Move>& moves) {
+
     bool canQueensideCastle = board.getCastlingRights(colour, Castling::QUEENSIDE);
     bool canKingsideCastle = board.getCastlingRights(colour, Castling::KINGSIDE);
 
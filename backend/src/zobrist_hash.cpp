@@ -15,6 +15,7 @@ using Chess::Castling;
 
 namespace {
     static constexpr uint8_t castleRookSquares[2][2] = {{5, 3}, {61, 59}};
+    static constexpr uint8_t castleRookStartSquares[2][2] = {{7, 0}, {63, 56}};
 }
 
 namespace Zobrist {
@@ -85,8 +86,10 @@ namespace Zobrist {
         // Deal with rook move in castling
         uint8_t castling = move.getCastling();
         if (castling != Move::NO_CASTLE) {
+            uint8_t castleRookStartSquare = castleRookStartSquares[toIndex(playerTurn)][castling];
             uint8_t castleRookSquare = castleRookSquares[toIndex(playerTurn)][castling];
             
+            currentHash ^= zobristTable[toIndex(playerTurn)][toIndex(Piece::ROOK)][castleRookStartSquare];
             currentHash ^= zobristTable[toIndex(playerTurn)][toIndex(Piece::ROOK)][castleRookSquare];
         }
 
@@ -126,6 +129,51 @@ namespace Zobrist {
         return currentHash;
     }
 
+    uint64_t computeInitialPawnHash(const Board& board) {
+        uint64_t pawnHash = 0;
+        constexpr Colour colours[2] = {Colour::WHITE, Colour::BLACK};
+
+        for (Colour colour : colours) {
+            Chess::Bitboard pawnsBitboard = board.getBitboard(Piece::PAWN, colour);
+            while (pawnsBitboard) {
+                uint8_t square = std::countr_zero(pawnsBitboard);
+                pawnHash ^= zobristTable[toIndex(colour)][toIndex(Piece::PAWN)][square];
+                pawnsBitboard &= pawnsBitboard - 1;
+            }
+        }
+
+        return pawnHash;
+    }
+
+    uint64_t updatePawnHash(uint64_t currentPawnHash, const Move move, const std::optional<uint8_t> oldEnPassantSquare,
+                            Chess::PieceColour playerTurn, Chess::PieceType movedPiece) {
+
+        constexpr uint8_t pawn = toIndex(Piece::PAWN);
+        Colour captureColour = (playerTurn == Colour::WHITE) ? Colour::BLACK : Colour::WHITE;
+
+        if (movedPiece == Piece::PAWN) {
+            // Remove old pawn hash
+            currentPawnHash ^= zobristTable[toIndex(playerTurn)][pawn][move.getFromSquare()];
+
+            // Pawn in promotion disappears so it is not added back
+            if (move.getPromotionPiece() == Move::NO_PROMOTION) {
+                currentPawnHash ^= zobristTable[toIndex(playerTurn)][pawn][move.getToSquare()];
+            }
+        }
+
+        // Captured pawn hash
+        if (move.getCapturedPiece() == pawn) {
+            // Capture square for en passant is different
+            uint8_t capturedSquare = (move.getEnPassant() != Move::NO_EN_PASSANT) ? 
+                                    *oldEnPassantSquare :
+                                    move.getToSquare();
+
+            currentPawnHash ^= zobristTable[toIndex(captureColour)][pawn][capturedSquare];
+        }
+
+        return currentPawnHash;
+    }
+
     uint64_t computeHash(const char* fen) {
         uint8_t rank = 7;
         uint8_t file = 0;
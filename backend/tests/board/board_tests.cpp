@@ -7,6 +7,7 @@
 #include "board/board.h"
 #include "tests/board/board_debug.h"
 #include "tests/board/board_utilities.h"
+#include "tests/move/move_debug.h"
 #include "chess_types.h"
 
 using Colour = Chess::PieceColour;
@@ -108,4 +109,56 @@ TEST(BoardTest, CheckGetPiece) {
 TEST(BoardTest, CheckGetEnPassantSquare) {
     Board b;
     ASSERT_FALSE(b.getEnPassantSquare());
+}
+
+TEST(BoardTest, IncrementalScores) {
+    Board b;
+    EXPECT_EQ(b.getMaterial(Colour::WHITE), 14000);
+    EXPECT_EQ(b.getMaterial(Colour::BLACK), 14000);
+    EXPECT_EQ(b.getPhase(), 24);
+
+    const Score pieceSquareScore = b.getPieceSquareScore(Colour::WHITE);
+    EXPECT_EQ(pieceSquareScore, b.getPieceSquareScore(Colour::BLACK));
+
+    b.removePiece(Piece::QUEEN, Colour::BLACK, 59);
+    EXPECT_EQ(b.getMaterial(Colour::BLACK), 13100);
+    EXPECT_EQ(b.getPhase(), 20);
+
+    b.movePiece(12, 28);
+    EXPECT_NE(b.getPieceSquareScore(Colour::WHITE), pieceSquareScore);
+    b.movePiece(28, 12);
+    EXPECT_EQ(b.getPieceSquareScore(Colour::WHITE), pieceSquareScore);
+
+    b.resetBoard();
+    EXPECT_EQ(b.getMaterial(Colour::BLACK), 14000);
+    EXPECT_EQ(b.getPhase(), 24);
+}
+
+TEST(BoardTest, AttackInformation) {
+    Board b;
+    EXPECT_EQ(b.attacksBy(Colour::WHITE), 0x0000000000FFFF7EULL);
+    EXPECT_EQ(b.checkers(Colour::WHITE), 0ULL);
+    EXPECT_EQ(b.pinned(Colour::WHITE), 0ULL);
+
+    // Knight on d2 is pinned by the bishop on b4 and the king is in check from the rook on h1
+    b.setCustomBoardState("4k3/8/8/8/1b6/8/3N4/4K2r w - - 0 1");
+    EXPECT_EQ(b.checkers(Colour::WHITE), 1ULL << algebraicToSquare("h1"));
+    EXPECT_EQ(b.pinned(Colour::WHITE), 1ULL << algebraicToSquare("d2"));
+    EXPECT_EQ(b.checkers(Colour::BLACK), 0ULL);
+    EXPECT_EQ(b.pinned(Colour::BLACK), 0ULL);
+
+    // Attack information is recomputed after a move and restored when it is undone
+    auto castlingRights = b.getCastlingRights();
+    auto enPassantSquare = b.getEnPassantSquare();
+    Move move(algebraicToSquare("e1"), algebraicToSquare("e2"));
+    b.makeMove(move, Colour::WHITE);
+    EXPECT_EQ(b.checkers(Colour::WHITE), 0ULL);
+    EXPECT_EQ(b.pinned(Colour::WHITE), 0ULL);
+    b.undo(move, Colour::WHITE, castlingRights, enPassantSquare);
+    EXPECT_EQ(b.checkers(Colour::WHITE), 1ULL << algebraicToSquare("h1"));
+    EXPECT_EQ(b.pinned(Colour::WHITE), 1ULL << algebraicToSquare("d2"));
+
+    // Changing pieces directly invalidates the cached attack information
+    b.removePiece(algebraicToSquare("b4"));
+    EXPECT_EQ(b.pinned(Colour::WHITE), 0ULL);
 }
\ No newline at end of file
@@ -0,0 +1,96 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <vector>
+#include "board/board.h"
+#include "game/game.h"
+#include "move/move.h"
+#include "move/move_generator.h"
+#include "engine/nnue.h"
+#include "engine/evaluation.h"
+#include "tests/move/move_debug.h"
+#include "chess_types.h"
+
+using Colour = Chess::PieceColour;
+
+namespace {
+    /**
+     * @brief Writes a network with random weights to a temporary file and loads it
+     * @param seed Seed of the random weights
+     */
+    void loadRandomNetwork(unsigned int seed = 12345) {
+        constexpr std::size_t parameterCount = NNUE::INPUT_SIZE * NNUE::HIDDEN_SIZE + NNUE::HIDDEN_SIZE + 2 * NNUE::HIDDEN_SIZE + 1;
+        std::mt19937 rng(seed);
+        std::uniform_int_distribution<int> distribution(-64, 64);
+
+        std::filesystem::path path = std::filesystem::temp_directory_path() / "chess_nnue_test.bin";
+        {
+            std::ofstream file(path, std::ios::binary);
+            for (std::size_t i = 0; i < parameterCount; i++) {
+                uint16_t value = static_cast<uint16_t>(static_cast<int16_t>(distribution(rng)));
+                file.put(static_cast<char>(value & 0xFF));
+                file.put(static_cast<char>(value >> 8));
+            }
+        }
+
+        ASSERT_TRUE(NNUE::load(path.string()));
+        std::filesystem::remove(path);
+    }
+}
+
+TEST(NNUETest, RejectsInvalidNetworkFile) {
+    EXPECT_FALSE(NNUE::load("this_network_does_not_exist.bin"));
+}
+
+TEST(NNUETest, IncrementalAccumulatorMatchesRefresh) {
+    loadRandomNetwork();
+
+    Game game;
+    Board& board = game.getBoard();
+    board.getAccumulator(); // Start updating the accumulator incrementally
+
+    std::mt19937 rng(42);
+    std::vector<Move> moves;
+    int movesMade = 0;
+
+    for (int ply = 0; ply < 60; ply++) {
+        moves.clear();
+        MoveGenerator::legalMoves(board, game.getCurrentTurn(), moves);
+        if (moves.empty()) break;
+
+        game.makeMove(moves[rng() % moves.size()]);
+        movesMade++;
+
+        Board refreshed = board;
+        refreshed.refreshAccumulator();
+        ASSERT_EQ(std::memcmp(board.getAccumulator().values, refreshed.getAccumulator().values, sizeof(NNUEAccumulator::values)), 0);
+        EXPECT_EQ(NNUE::evaluate(board.getAccumulator(), game.getCurrentTurn()),
+                  NNUE::evaluate(refreshed.getAccumulator(), game.getCurrentTurn()));
+    }
+
+    // Undoing every move restores the accumulator of the starting position
+    for (int i = 0; i < movesMade; i++) game.undo();
+
+    Board initial;
+    ASSERT_EQ(std::memcmp(board.getAccumulator().values, initial.getAccumulator().values, sizeof(NNUEAccumulator::values)), 0);
+}
+TEST(NNUETest, LoadingNetworkClearsEvaluationCache) {
+    Evaluation::setEvaluationMode(EvaluationMode::NNUE);
+    loadRandomNetwork(1);
+
+    Game game;
+    game.makeMove(Move(algebraicToSquare("e2"), algebraicToSquare("e4")));
+    Evaluation::evaluate(game, GameStateEvaluation::IN_PROGRESS, 0);
+    EXPECT_GT(Evaluation::getEvalCache().getProbes(), 0u);
+
+    // The position must be evaluated by the new network rather than taken from the cache
+    loadRandomNetwork(2);
+    EXPECT_EQ(Evaluation::getEvalCache().getProbes(), 0u);
+    EXPECT_EQ(Evaluation::evaluate(game, GameStateEvaluation::IN_PROGRESS, 0), Evaluation::staticEvaluation(game));
+    EXPECT_EQ(Evaluation::getEvalCache().getHits(), 0u);
+
+    Evaluation::setEvaluationMode(EvaluationMode::CLASSICAL);
+}
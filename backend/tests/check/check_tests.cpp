@@ -91,4 +91,21 @@ TEST(checkTest, board5) {
     // White king on b2
     colour = Colour::WHITE;
     ASSERT_TRUE(Check::isInCheck(b, colour));
+}
+
+TEST(checkTest, attackersTo) {
+    Board b;
+
+    b.setCustomBoardState("1k1r3q/1ppn3p/p4b2/4p3/8/P2N2P1/1PP1R1BP/2K1Q3 w - - 0 1");
+    //printBoard(b); // View visual board for test
+
+    uint8_t square = algebraicToSquare("e5");
+    Bitboard expected = (1ULL << algebraicToSquare("d3")) | (1ULL << algebraicToSquare("e2")) | 
+                        (1ULL << algebraicToSquare("d7")) | (1ULL << algebraicToSquare("f6"));
+    EXPECT_EQ(b.attackersTo(square), expected);
+
+    // Once the rook on e2 is removed the queen behind it attacks e5
+    Bitboard occupied = b.getPiecesBitboard() & ~(1ULL << algebraicToSquare("e2"));
+    expected = (expected & ~(1ULL << algebraicToSquare("e2"))) | (1ULL << algebraicToSquare("e1"));
+    EXPECT_EQ(b.attackersTo(square, occupied), expected);
 }
\ No newline at end of file
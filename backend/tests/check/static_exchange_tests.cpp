@@ -0,0 +1,51 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include "board/board.h"
+#include "move/move.h"
+#include "engine/evaluation.h"
+#include "tests/move/move_debug.h"
+#include "chess_types.h"
+
+using Piece = Chess::PieceType;
+using Chess::toIndex;
+
+TEST(staticExchangeTest, undefendedCapture) {
+    Board b;
+    b.setCustomBoardState("1k1r4/1pp4p/p7/4p3/8/P5P1/1PP4P/2K1R3 w - - 0 1");
+
+    // Rook takes a free pawn
+    Move move(algebraicToSquare("e1"), algebraicToSquare("e5"), toIndex(Piece::PAWN));
+    EXPECT_TRUE(Evaluation::staticExchangeAtLeast(b, move));
+    EXPECT_TRUE(Evaluation::staticExchangeAtLeast(b, move, Evaluation::getPieceValue(toIndex(Piece::PAWN))));
+    EXPECT_FALSE(Evaluation::staticExchangeAtLeast(b, move, Evaluation::getPieceValue(toIndex(Piece::PAWN)) + 1));
+}
+
+TEST(staticExchangeTest, defendedCapture) {
+    Board b;
+    b.setCustomBoardState("1k1r3q/1ppn3p/p4b2/4p3/8/P2N2P1/1PP1R1BP/2K1Q3 w - - 0 1");
+
+    // Knight takes a pawn defended twice, attacked three times but the knight is worth more than the pawn
+    Move move(algebraicToSquare("d3"), algebraicToSquare("e5"), toIndex(Piece::PAWN));
+    EXPECT_FALSE(Evaluation::staticExchangeAtLeast(b, move));
+    EXPECT_TRUE(Evaluation::staticExchangeAtLeast(b, move, Evaluation::getPieceValue(toIndex(Piece::PAWN)) - 
+                                                           Evaluation::getPieceValue(toIndex(Piece::KNIGHT))));
+}
+
+TEST(staticExchangeTest, xrayRecapture) {
+    Board b;
+    b.setCustomBoardState("3r2k1/8/8/3p4/8/8/3R4/3R2K1 w - - 0 1");
+
+    // Rook takes a pawn defended by a rook, the second rook recaptures through the first
+    Move move(algebraicToSquare("d2"), algebraicToSquare("d5"), toIndex(Piece::PAWN));
+    EXPECT_TRUE(Evaluation::staticExchangeAtLeast(b, move));
+    EXPECT_TRUE(Evaluation::staticExchangeAtLeast(b, move, Evaluation::getPieceValue(toIndex(Piece::PAWN))));
+}
+
+TEST(staticExchangeTest, quietMoveToAttackedSquare) {
+    Board b;
+    b.setCustomBoardState("4k3/8/8/8/6p1/8/8/3QK1N1 w - - 0 1");
+
+    // Knight moves onto a square attacked by a pawn
+    EXPECT_FALSE(Evaluation::staticExchangeAtLeast(b, Move(algebraicToSquare("g1"), algebraicToSquare("f3"))));
+    EXPECT_TRUE(Evaluation::staticExchangeAtLeast(b, Move(algebraicToSquare("g1"), algebraicToSquare("e2"))));
+}
\ No newline at end of file
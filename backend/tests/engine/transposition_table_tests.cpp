@@ -0,0 +1,72 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include "engine/transposition_table.h"
+#include "move/move.h"
+
+namespace {
+    constexpr uint64_t KEY = 0x123456789ABCDEF0ULL;
+
+    TTEntry makeEntry(TranspositionTable& tt, int16_t eval, int8_t depth, TTFlag flag, Move bestMove) {
+        return {KEY, eval, depth, tt.getGeneration(), flag, bestMove};
+    }
+}
+
+TEST(transpositionTableTest, shallowBoundKeepsDeeperEntry) {
+    TranspositionTable tt(1);
+    Move move(12, 28);
+
+    tt.add(KEY, makeEntry(tt, 50, 6, TTFlag::LOWER_BOUND, move));
+    // Quiescence fail low of the same position without a best move
+    tt.add(KEY, makeEntry(tt, -20, -1, TTFlag::UPPER_BOUND, Move()));
+
+    EXPECT_EQ(tt.getBestMove(KEY), move);
+    TTEntry* entry = tt.getEntry(KEY);
+    ASSERT_NE(entry, nullptr);
+    EXPECT_EQ(entry->depth, 6);
+    EXPECT_EQ(entry->flag, TTFlag::LOWER_BOUND);
+    EXPECT_EQ(entry->eval, 50);
+}
+
+TEST(transpositionTableTest, deeperEntryReplacesSameKey) {
+    TranspositionTable tt(1);
+    Move move(12, 28);
+
+    tt.add(KEY, makeEntry(tt, 50, 3, TTFlag::LOWER_BOUND, move));
+    tt.add(KEY, makeEntry(tt, 10, 6, TTFlag::UPPER_BOUND, Move()));
+
+    // The deeper entry is stored but the best move of the previous entry is kept
+    TTEntry* entry = tt.getEntry(KEY);
+    ASSERT_NE(entry, nullptr);
+    EXPECT_EQ(entry->depth, 6);
+    EXPECT_EQ(entry->eval, 10);
+    EXPECT_EQ(entry->bestMove, move);
+}
+
+TEST(transpositionTableTest, sameKeyOccupiesOneSlot) {
+    TranspositionTable tt(1);
+    Move oldMove(12, 28);
+    Move newMove(6, 21);
+
+    tt.add(KEY, makeEntry(tt, 50, 3, TTFlag::LOWER_BOUND, oldMove));
+    tt.add(KEY, makeEntry(tt, 80, 6, TTFlag::EXACT, newMove));
+
+    EXPECT_EQ(tt.getBestMove(KEY), newMove);
+    TTEntry* entry = tt.getEntry(KEY);
+    ASSERT_NE(entry, nullptr);
+    EXPECT_EQ(entry->depth, 6);
+    EXPECT_EQ(entry->flag, TTFlag::EXACT);
+}
+
+TEST(transpositionTableTest, newerGenerationReplacesSameKey) {
+    TranspositionTable tt(1);
+    Move move(12, 28);
+
+    tt.add(KEY, makeEntry(tt, 50, 6, TTFlag::LOWER_BOUND, move));
+    tt.incrementGeneration();
+    tt.add(KEY, makeEntry(tt, -20, -1, TTFlag::UPPER_BOUND, Move()));
+
+    TTEntry* entry = tt.getEntry(KEY);
+    ASSERT_NE(entry, nullptr);
+    EXPECT_EQ(entry->depth, -1);
+    EXPECT_EQ(entry->bestMove, move);
+}
@@ -0,0 +1,170 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <cstddef>
+#include <random>
+#include <vector>
+#include <algorithm>
+#include "board/board.h"
+#include "move/move.h"
+#include "move/move_generator.h"
+#include "game/game.h"
+#include "check/check.h"
+#include "tests/move/move_debug.h"
+#include "chess_types.h"
+
+using Colour = Chess::PieceColour;
+using Chess::toIndex;
+
+namespace {
+    constexpr const char* corpusStartPositions[] = {
+        "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+        "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+        "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+        "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+        "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8"
+    };
+
+    constexpr int CORPUS_POSITIONS_PER_START = 400;
+    constexpr int MAX_PLAYOUT_LENGTH = 60;
+    constexpr std::size_t CANDIDATE_POOL_SIZE = 512;
+
+    bool isLegalByMakingMove(Board& board, Colour colour, Move move) {
+        auto castlingRightsBeforeMove = board.getCastlingRights();
+        auto enPassantSquareBeforeMove = board.getEnPassantSquare();
+
+        board.makeMove(move, colour);
+        bool inCheck = Check::isInCheck(board, colour);
+        board.undo(move, colour, castlingRightsBeforeMove, enPassantSquareBeforeMove);
+
+        return !inCheck;
+    }
+
+    /**
+     * Plays random legal moves from each start position and calls check on every position reached
+     * Playouts restart from the start position when the game ends or the playout gets too long
+     */
+    template <typename Function>
+    void forEachCorpusPosition(uint64_t seed, Function check) {
+        std::mt19937_64 rng(seed);
+        std::vector<Move> legalMoves;
+
+        for (const char* fen : corpusStartPositions) {
+            Game game;
+            game.setCustomGameState(fen);
+            int playoutLength = 0;
+
+            for (int i = 0; i < CORPUS_POSITIONS_PER_START; i++) {
+                check(game.getBoard(), game.getCurrentTurn(), rng);
+
+                legalMoves.clear();
+                MoveGenerator::legalMoves(game.getBoard(), game.getCurrentTurn(), legalMoves);
+                if (legalMoves.empty() || ++playoutLength >= MAX_PLAYOUT_LENGTH) {
+                    game.setCustomGameState(fen);
+                    playoutLength = 0;
+                    continue;
+                }
+
+                game.makeMove(legalMoves[rng() % legalMoves.size()]);
+            }
+        }
+    }
+}
+
+TEST(legalityTest, generatedMovesArePseudoLegal) {
+    std::vector<Move> pseudoLegalMoves;
+    forEachCorpusPosition(1, [&](Board& board, Colour colour, std::mt19937_64&) {
+        pseudoLegalMoves.clear();
+        MoveGenerator::pseudoLegalMoves(board, colour, pseudoLegalMoves);
+
+        for (Move move : pseudoLegalMoves) {
+            ASSERT_TRUE(MoveGenerator::isPseudoLegal(board, colour, move)) << move;
+        }
+    });
+}
+
+TEST(legalityTest, otherMovesAreNotPseudoLegal) {
+    std::vector<Move> pseudoLegalMoves;
+    std::vector<Move> candidates; // Moves from earlier positions, as found in the transposition and killer move tables
+    std::size_t nextCandidate = 0;
+
+    forEachCorpusPosition(2, [&](Board& board, Colour colour, std::mt19937_64& rng) {
+        pseudoLegalMoves.clear();
+        MoveGenerator::pseudoLegalMoves(board, colour, pseudoLegalMoves);
+
+        for (Move candidate : candidates) {
+            bool generated = std::find(pseudoLegalMoves.begin(), pseudoLegalMoves.end(), candidate) != pseudoLegalMoves.end();
+            ASSERT_EQ(MoveGenerator::isPseudoLegal(board, colour, candidate), generated) << candidate;
+        }
+
+        // Random moves with arbitrary flags are almost never pseudo legal
+        for (int i = 0; i < 64; i++) {
+            Move candidate(rng() % 64, rng() % 64, rng() % 7, rng() % 7, rng() % 3, rng() % 2);
+            bool generated = std::find(pseudoLegalMoves.begin(), pseudoLegalMoves.end(), candidate) != pseudoLegalMoves.end();
+            ASSERT_EQ(MoveGenerator::isPseudoLegal(board, colour, candidate), generated) << candidate;
+        }
+        EXPECT_FALSE(MoveGenerator::isPseudoLegal(board, colour, Move()));
+
+        for (Move move : pseudoLegalMoves) {
+            if (candidates.size() < CANDIDATE_POOL_SIZE) {
+                candidates.push_back(move);
+            } else {
+                candidates[nextCandidate] = move;
+                nextCandidate = (nextCandidate + 1) % CANDIDATE_POOL_SIZE;
+            }
+        }
+    });
+}
+
+TEST(legalityTest, isLegalMatchesMakingMove) {
+    std::vector<Move> pseudoLegalMoves;
+    forEachCorpusPosition(3, [&](Board& board, Colour colour, std::mt19937_64&) {
+        pseudoLegalMoves.clear();
+        MoveGenerator::pseudoLegalMoves(board, colour, pseudoLegalMoves);
+
+        for (Move move : pseudoLegalMoves) {
+            ASSERT_EQ(MoveGenerator::isLegal(board, colour, move), isLegalByMakingMove(board, colour, move)) << move;
+        }
+    });
+}
+
+TEST(legalityTest, evasionsAreLegalMovesInCheck) {
+    std::vector<Move> evasions;
+    std::vector<Move> legalMoves;
+    int positionsInCheck = 0;
+
+    forEachCorpusPosition(4, [&](Board& board, Colour colour, std::mt19937_64&) {
+        if (!Check::isInCheck(board, colour)) return;
+        positionsInCheck++;
+
+        evasions.clear();
+        MoveGenerator::pseudoLegalEvasions(board, colour, evasions);
+        std::erase_if(evasions, [&](Move move) { return !MoveGenerator::isLegal(board, colour, move); });
+
+        legalMoves.clear();
+        MoveGenerator::legalMoves(board, colour, legalMoves);
+
+        ASSERT_EQ(evasions.size(), legalMoves.size());
+        for (Move move : evasions) {
+            ASSERT_NE(std::find(legalMoves.begin(), legalMoves.end(), move), legalMoves.end()) << move;
+        }
+    });
+
+    EXPECT_GT(positionsInCheck, 0);
+}
+
+TEST(legalityTest, pinnedPieces) {
+    Board b;
+    b.setCustomBoardState("4k3/8/8/8/1b6/8/3N4/4K2r w - - 0 1");
+    Colour colour = Colour::WHITE;
+
+    // Knight on d2 is pinned by the bishop on b4 and the king is in check from the rook on h1
+    EXPECT_FALSE(MoveGenerator::isLegal(b, colour, Move(algebraicToSquare("d2"), algebraicToSquare("f1"))));
+    EXPECT_TRUE(MoveGenerator::isLegal(b, colour, Move(algebraicToSquare("e1"), algebraicToSquare("e2"))));
+    EXPECT_FALSE(MoveGenerator::isLegal(b, colour, Move(algebraicToSquare("e1"), algebraicToSquare("f1"))));
+    EXPECT_FALSE(MoveGenerator::isLegal(b, colour, Move(algebraicToSquare("e1"), algebraicToSquare("d1"))));
+
+    // En passant which removes both pawns from the rank of the king
+    b.setCustomBoardState("8/8/8/K2pP2r/8/8/8/7k w - d6 0 1");
+    EXPECT_FALSE(MoveGenerator::isLegal(b, colour, Move(algebraicToSquare("e5"), algebraicToSquare("d6"),
+                                                        toIndex(Chess::PieceType::PAWN), Move::NO_PROMOTION, Move::NO_CASTLE, 1)));
+}
\ No newline at end of file
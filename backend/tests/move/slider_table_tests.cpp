@@ -0,0 +1,56 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <random>
+#include "move/precompute_moves.h"
+#include "chess_types.h"
+
+using Chess::Bitboard;
+
+namespace {
+    // Walks each ray from the square until the edge of the board or the first occupied square (inclusive)
+    Bitboard rayMoves(int square, Bitboard occupied, const int (&directions)[4][2]) {
+        Bitboard moves = 0ULL;
+        for (const auto& direction : directions) {
+            int file = square % 8 + direction[0];
+            int rank = square / 8 + direction[1];
+            while (0 <= file && file < 8 && 0 <= rank && rank < 8) {
+                Bitboard bit = 1ULL << (8 * rank + file);
+                moves |= bit;
+                if (occupied & bit) break;
+
+                file += direction[0];
+                rank += direction[1];
+            }
+        }
+
+        return moves;
+    }
+
+    constexpr int rookDirections[4][2] = {{-1, 0}, {1, 0}, {0, -1}, {0, 1}};
+    constexpr int bishopDirections[4][2] = {{-1, -1}, {-1, 1}, {1, -1}, {1, 1}};
+    constexpr int RANDOM_OCCUPANCIES = 2000;
+}
+
+TEST(sliderTableTest, rookMovesMatchRayWalk) {
+    std::mt19937_64 rng(12345);
+    for (int square = 0; square < 64; square++) {
+        EXPECT_EQ(PrecomputeMoves::getRookMovesFromTable(square, 0ULL), rayMoves(square, 0ULL, rookDirections));
+
+        for (int i = 0; i < RANDOM_OCCUPANCIES; i++) {
+            Bitboard occupied = rng() & rng(); // Roughly a quarter of the squares occupied
+            ASSERT_EQ(PrecomputeMoves::getRookMovesFromTable(square, occupied), rayMoves(square, occupied, rookDirections));
+        }
+    }
+}
+
+TEST(sliderTableTest, bishopMovesMatchRayWalk) {
+    std::mt19937_64 rng(54321);
+    for (int square = 0; square < 64; square++) {
+        EXPECT_EQ(PrecomputeMoves::getBishopMovesFromTable(square, 0ULL), rayMoves(square, 0ULL, bishopDirections));
+
+        for (int i = 0; i < RANDOM_OCCUPANCIES; i++) {
+            Bitboard occupied = rng() & rng(); // Roughly a quarter of the squares occupied
+            ASSERT_EQ(PrecomputeMoves::getBishopMovesFromTable(square, occupied), rayMoves(square, occupied, bishopDirections));
+        }
+    }
+}
\ No newline at end of file
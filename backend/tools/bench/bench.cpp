@@ -0,0 +1,340 @@
+#include <cstdint>
+#include <cstdlib>
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <functional>
+#include <utility>
+#include "game/game.h"
+#include "engine/engine.h"
+#include "engine/evaluation.h"
+#include "engine/pawn_hash_table.h"
+#include "engine/eval_cache.h"
+#include "engine/nnue.h"
+
+namespace {
+    constexpr const char* benchPositions[] = {
+        "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+        "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+        "r1bqkb1r/pppp1ppp/2n2n2/4p3/2B1P3/5N2/PPPP1PPP/RNBQK2R w KQkq - 4 4",
+        "r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10",
+        "4rrk1/pp1n3p/3q2pQ/2p1pb2/2PP4/2P3N1/P2B2PP/4RRK1 b - - 7 19",
+        "r3r1k1/2p2ppp/p1p1bn2/8/1q2P3/2NPQN2/PPP3PP/R4R1K b - - 2 15",
+        "2r3k1/pp2qppp/3p4/3Pn3/4P3/1P6/P1Q2PPP/2R3K1 w - - 0 1",
+        "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8",
+        "6k1/6p1/6Pp/ppp5/3pn2P/1P3K2/1PP2P2/8 b - - 0 1",
+        "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1"
+    };
+
+    constexpr int BENCH_TIME_LIMIT = 1000000; // Effectively unlimited so that only depth limits the search
+    constexpr uint8_t BENCH_QUIESCENCE_DEPTH = 8;
+    constexpr int EVAL_SPEED_ITERATIONS = 200000;
+
+    volatile int64_t evaluationChecksum = 0; // Written with the sum of the timed evaluations so that they are not optimised away
+
+    struct PositionResult {
+        Move move;
+        int16_t eval;
+        uint64_t nodes;
+        uint64_t quiescenceNodes;
+        uint64_t lateMovePrunes;
+        uint64_t historyPrunes;
+        uint64_t singularExtensions;
+        uint64_t multiCuts;
+        uint64_t probCuts;
+        int64_t milliseconds;
+    };
+
+    /**
+     * @brief Measures the number of static evaluations per second of the selected evaluation mode over the bench positions
+     * @note The evaluation cache is bypassed so that every call performs a full evaluation
+     */
+    double evaluationsPerSecond() {
+        int64_t evaluations = 0;
+        int64_t checksum = 0;
+        auto start = std::chrono::steady_clock::now();
+
+        for (const char* fen : benchPositions) {
+            Game game;
+            game.setCustomGameState(fen);
+            for (int i = 0; i < EVAL_SPEED_ITERATIONS; i++) {
+                checksum += Evaluation::staticEvaluation(game);
+            }
+            evaluations += EVAL_SPEED_ITERATIONS;
+        }
+
+        auto end = std::chrono::steady_clock::now();
+        evaluationChecksum = checksum;
+        double seconds = std::chrono::duration<double>(end - start).count();
+        return evaluations / seconds;
+    }
+
+    /**
+     * @brief Searches every bench position with a fresh engine, history table and evaluation caches
+     * @note The tables are cleared so that the node counts of a suite do not depend on the suites run before it
+     * @param configure Called on the engine before searching to change its settings from the defaults
+     * @return Search result of each bench position
+     */
+    std::vector<PositionResult> runSuite(uint8_t depth, const std::function<void(Engine&)>& configure = [](Engine&) {}) {
+        Evaluation::clearHistoryHeuristicsTable();
+        Evaluation::clearEvaluationCaches();
+        Engine engine(BENCH_TIME_LIMIT, depth, BENCH_QUIESCENCE_DEPTH);
+        configure(engine);
+        std::vector<PositionResult> results;
+
+        for (const char* fen : benchPositions) {
+            Game game;
+            game.setCustomGameState(fen);
+
+            auto positionStart = std::chrono::steady_clock::now();
+            Move move = engine.getMove(game);
+            auto positionEnd = std::chrono::steady_clock::now();
+
+            const SearchStats& stats = engine.getStats();
+            results.push_back({move, engine.getCurrentEvaluation(), stats.nodes, stats.quiescenceNodes,
+                               stats.lateMovePrunes, stats.historyPrunes, stats.singularExtensions, stats.multiCuts, stats.probCuts,
+                               std::chrono::duration_cast<std::chrono::milliseconds>(positionEnd - positionStart).count()});
+        }
+
+        return results;
+    }
+
+    /**
+     * @brief Searches the bench positions again without lazy evaluation and reports how much the results differ
+     * @param lazyResults Results of the search with lazy evaluation enabled
+     */
+    void reportLazyEvaluationDrift(uint8_t depth, const std::vector<PositionResult>& lazyResults) {
+        Evaluation::setLazyEvaluation(false);
+        std::vector<PositionResult> fullResults = runSuite(depth);
+        Evaluation::setLazyEvaluation(true);
+
+        int differentMoves = 0;
+        int64_t totalEvalDifference = 0;
+        uint64_t lazyNodes = 0;
+        uint64_t fullNodes = 0;
+        for (std::size_t i = 0; i < lazyResults.size(); i++) {
+            if (lazyResults[i].move != fullResults[i].move) differentMoves++;
+            totalEvalDifference += std::abs(lazyResults[i].eval - fullResults[i].eval);
+            lazyNodes += lazyResults[i].nodes + lazyResults[i].quiescenceNodes;
+            fullNodes += fullResults[i].nodes + fullResults[i].quiescenceNodes;
+        }
+
+        std::cout << "Lazy eval drift : " << differentMoves << "/" << lazyResults.size() << " best moves differ, mean eval difference "
+                  << std::setprecision(1) << static_cast<double>(totalEvalDifference) / lazyResults.size() << " cp, "
+                  << lazyNodes << " vs " << fullNodes << " nodes without lazy eval\n";
+    }
+
+    /**
+     * @brief Sums the nodes (including quiescence nodes) and time of a search of the bench positions
+     * @return Pair of the total nodes and milliseconds
+     */
+    std::pair<uint64_t, int64_t> totals(const std::vector<PositionResult>& results) {
+        uint64_t nodes = 0;
+        int64_t milliseconds = 0;
+        for (const PositionResult& result : results) {
+            nodes += result.nodes + result.quiescenceNodes;
+            milliseconds += result.milliseconds;
+        }
+        return {nodes, milliseconds};
+    }
+
+    /**
+     * @brief Searches the bench positions with each handling of nodes without a transposition table move and reports the time to depth
+     */
+    void reportInternalIterative(uint8_t depth) {
+        const std::pair<const char*, InternalIterativeMode> modes[] = {
+            {"none", InternalIterativeMode::NONE},
+            {"reduction", InternalIterativeMode::REDUCTION}
+        };
+
+        std::cout << "Internal iterative (all nodes, time to depth " << static_cast<int>(depth) << "):\n";
+        for (const auto& [name, mode] : modes) {
+            auto [nodes, milliseconds] = totals(runSuite(depth, [&](Engine& engine) {
+                engine.setInternalIterativeMode(mode);
+            }));
+            std::cout << "  " << std::left << std::setw(20) << name << std::right << std::setw(12) << nodes
+                      << std::setw(8) << milliseconds << " ms\n";
+        }
+    }
+
+    /**
+     * @brief Searches the bench positions with quiet checks in each range of quiescence plies and reports the quiescence nodes
+     */
+    void reportQuiescenceChecks(uint8_t depth) {
+        const std::pair<const char*, QuiescenceChecksMode> modes[] = {
+            {"none", QuiescenceChecksMode::NONE},
+            {"first ply", QuiescenceChecksMode::FIRST_PLY},
+            {"all plies", QuiescenceChecksMode::ALL_PLIES}
+        };
+
+        std::cout << "Quiescence checks (qnodes, all nodes, time to depth " << static_cast<int>(depth) << "):\n";
+        for (const auto& [name, mode] : modes) {
+            const std::vector<PositionResult> results = runSuite(depth, [&](Engine& engine) {
+                engine.setQuiescenceChecksMode(mode);
+            });
+
+            uint64_t quiescenceNodes = 0;
+            for (const PositionResult& result : results) quiescenceNodes += result.quiescenceNodes;
+            auto [nodes, milliseconds] = totals(results);
+            std::cout << "  " << std::left << std::setw(20) << name << std::right << std::setw(12) << quiescenceNodes
+                      << std::setw(12) << nodes << std::setw(8) << milliseconds << " ms\n";
+        }
+    }
+
+    /**
+     * @brief Searches the bench positions again with each forward pruning technique disabled in turn and reports the cost
+     * @param results Results of the search with the default pruning
+     */
+    void reportPruning(uint8_t depth, const std::vector<PositionResult>& results) {
+
+        PruningParameters withoutReverseFutility;
+        withoutReverseFutility.reverseFutilityPruning = false;
+        PruningParameters withoutFutility;
+        withoutFutility.futilityPruning = false;
+        PruningParameters withoutRazoring;
+        withoutRazoring.razoring = false;
+        PruningParameters withoutLateMovePruning;
+        withoutLateMovePruning.lateMovePruning = false;
+        PruningParameters withoutHistoryPruning;
+        withoutHistoryPruning.historyPruning = false;
+        PruningParameters withoutProbCut;
+        withoutProbCut.probCut = false;
+        PruningParameters withoutAny;
+        withoutAny.reverseFutilityPruning = withoutAny.futilityPruning = withoutAny.razoring = false;
+        withoutAny.lateMovePruning = withoutAny.historyPruning = withoutAny.probCut = false;
+
+        const std::pair<const char*, PruningParameters> configurations[] = {
+            {"no reverse futility", withoutReverseFutility},
+            {"no futility", withoutFutility},
+            {"no razoring", withoutRazoring},
+            {"no late move", withoutLateMovePruning},
+            {"no history", withoutHistoryPruning},
+            {"no probcut", withoutProbCut},
+            {"no forward pruning", withoutAny}
+        };
+
+        auto [nodes, milliseconds] = totals(results);
+        std::cout << "Pruning (all nodes, time):\n"
+                  << "  " << std::left << std::setw(20) << "all enabled" << std::right << std::setw(12) << nodes
+                  << std::setw(8) << milliseconds << " ms\n";
+
+        for (const auto& [name, pruning] : configurations) {
+            auto [configurationNodes, configurationMilliseconds] = totals(runSuite(depth, [&](Engine& engine) {
+                engine.setPruningParameters(pruning);
+            }));
+            std::cout << "  " << std::left << std::setw(20) << name << std::right << std::setw(12) << configurationNodes
+                      << std::setw(8) << configurationMilliseconds << " ms  (" << std::fixed << std::setprecision(1)
+                      << 100.0 * (static_cast<double>(configurationNodes) - nodes) / configurationNodes << "% saved by it)\n";
+        }
+    }
+}
+
+/**
+ * Searches a fixed set of positions to a fixed depth and reports node counts and speed
+ * If a network file is given the search uses the NNUE evaluation
+ * With --lazy-drift the positions are searched again without lazy evaluation to measure its effect on the results
+ * With --pruning the positions are searched again with each forward pruning technique disabled
+ * With --iir the positions are searched again with each internal iterative mode
+ * With --qsearch the positions are searched again with quiet checks in no, the first or every quiescence ply
+ * Usage: Bench [depth] [network file] [--lazy-drift] [--pruning] [--iir] [--qsearch]
+ */
+int main(int argc, char** argv) {
+    std::vector<std::string> arguments;
+    bool lazyDrift = false;
+    bool pruningReport = false;
+    bool internalIterativeReport = false;
+    bool quiescenceChecksReport = false;
+    for (int i = 1; i < argc; i++) {
+        if (std::string(argv[i]) == "--lazy-drift") {
+            lazyDrift = true;
+        } else if (std::string(argv[i]) == "--pruning") {
+            pruningReport = true;
+        } else if (std::string(argv[i]) == "--iir") {
+            internalIterativeReport = true;
+        } else if (std::string(argv[i]) == "--qsearch") {
+            quiescenceChecksReport = true;
+        } else {
+            arguments.push_back(argv[i]);
+        }
+    }
+
+    const uint8_t depth = (arguments.size() > 0) ? static_cast<uint8_t>(std::atoi(arguments[0].c_str())) : 7;
+
+    if (arguments.size() > 1) {
+        if (!NNUE::load(arguments[1])) {
+            std::cerr << "Failed to load network " << arguments[1] << "\n";
+            return 1;
+        }
+        Evaluation::setEvaluationMode(EvaluationMode::NNUE);
+    }
+
+    uint64_t totalNodes = 0;
+    uint64_t totalQuiescenceNodes = 0;
+    uint64_t totalLateMovePrunes = 0;
+    uint64_t totalHistoryPrunes = 0;
+    uint64_t totalSingularExtensions = 0;
+    uint64_t totalMultiCuts = 0;
+    uint64_t totalProbCuts = 0;
+    auto start = std::chrono::steady_clock::now();
+
+    std::vector<PositionResult> results = runSuite(depth);
+    for (std::size_t i = 0; i < results.size(); i++) {
+        const PositionResult& result = results[i];
+        totalNodes += result.nodes;
+        totalQuiescenceNodes += result.quiescenceNodes;
+        totalLateMovePrunes += result.lateMovePrunes;
+        totalHistoryPrunes += result.historyPrunes;
+        totalSingularExtensions += result.singularExtensions;
+        totalMultiCuts += result.multiCuts;
+        totalProbCuts += result.probCuts;
+
+        std::cout << benchPositions[i] << "\n"
+                  << "  move " << static_cast<int>(result.move.getFromSquare()) << "-" << static_cast<int>(result.move.getToSquare())
+                  << " eval " << result.eval
+                  << " nodes " << result.nodes
+                  << " qnodes " << result.quiescenceNodes
+                  << " time " << result.milliseconds << " ms\n";
+    }
+
+    auto end = std::chrono::steady_clock::now();
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+    uint64_t allNodes = totalNodes + totalQuiescenceNodes;
+    const PawnHashTable& pawnHashTable = Evaluation::getPawnHashTable();
+    double pawnHashHitRate = pawnHashTable.getProbes() ? 100.0 * pawnHashTable.getHits() / pawnHashTable.getProbes() : 0.0;
+    const EvalCache& evalCache = Evaluation::getEvalCache();
+    double evalCacheHitRate = evalCache.getProbes() ? 100.0 * evalCache.getHits() / evalCache.getProbes() : 0.0;
+    const LazyEvaluationStats& lazyStats = Evaluation::getLazyEvaluationStats();
+    double lazyExitRate = lazyStats.calls ? 100.0 * lazyStats.exits / lazyStats.calls : 0.0;
+
+    std::cout << "===========================\n"
+              << "Total time (ms) : " << elapsed << "\n"
+              << "Nodes searched  : " << totalNodes << "\n"
+              << "Qnodes searched : " << totalQuiescenceNodes << "\n"
+              << "Nodes/second    : " << (elapsed > 0 ? 1000 * allNodes / elapsed : allNodes) << "\n"
+              << "Late move prunes: " << totalLateMovePrunes << " nodes\n"
+              << "History prunes  : " << totalHistoryPrunes << " moves\n"
+              << "Singular exts   : " << totalSingularExtensions << " (" << totalMultiCuts << " multi-cuts)\n"
+              << "ProbCuts        : " << totalProbCuts << " nodes\n"
+              << "Pawn hash hits  : " << std::fixed << std::setprecision(1) << pawnHashHitRate << "%\n"
+              << "Eval cache hits : " << evalCacheHitRate << "% of " << evalCache.getProbes() << " probes\n"
+              << "Lazy eval exits : " << lazyExitRate << "% of " << lazyStats.calls << " windowed evaluations\n";
+
+    if (lazyDrift && Evaluation::getEvaluationMode() == EvaluationMode::CLASSICAL) {
+        reportLazyEvaluationDrift(depth, results);
+    }
+
+    if (pruningReport) reportPruning(depth, results);
+    if (internalIterativeReport) reportInternalIterative(depth);
+    if (quiescenceChecksReport) reportQuiescenceChecks(depth);
+
+    Evaluation::setEvaluationMode(EvaluationMode::CLASSICAL);
+    std::cout << "Classical evals/second : " << std::setprecision(0) << evaluationsPerSecond() << "\n";
+    if (NNUE::isLoaded()) {
+        Evaluation::setEvaluationMode(EvaluationMode::NNUE);
+        std::cout << "NNUE evals/second      : " << evaluationsPerSecond() << " (" << NNUE::getKernelName() << ")\n";
+    }
+
+    return 0;
+}
\ No newline at end of file
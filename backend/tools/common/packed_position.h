@@ -0,0 +1,144 @@
+#ifndef PACKED_POSITION_H
+#define PACKED_POSITION_H
+
+#include <cstdint>
+#include <string>
+#include <bit>
+#include "game/game.h"
+#include "board/board.h"
+#include "chess_types.h"
+
+/**
+ * Fixed size training record of a single position
+ * Pieces are stored as 4 bit codes (colour << 3 | piece) in ascending square order of the occupancy bitboard,
+ * two per byte with the lower square in the low nibble
+ * @note Records are written in host byte order (little endian on all supported platforms)
+ */
+struct PackedPosition {
+    uint64_t occupancy; ///< Bitboard of all occupied squares
+    uint8_t pieces[16]; ///< Piece codes of the occupied squares
+    int16_t score; ///< Search score in centipawns from white's perspective
+    uint8_t result; ///< Game result from white's perspective (0 = loss, 1 = draw, 2 = win)
+    uint8_t flags; ///< Bit 0 is the side to move (1 = black), bits 1-4 are the castling rights (WK, WQ, BK, BQ)
+    uint8_t enPassantSquare; ///< Square of the pawn that can be captured en passant, NO_EN_PASSANT_SQUARE if none
+    uint8_t halfMoveClock;
+    uint16_t fullMoves;
+};
+
+static_assert(sizeof(PackedPosition) == 32, "PackedPosition must be 32 bytes");
+
+namespace PackedPositionFormat {
+    using Piece = Chess::PieceType;
+    using Colour = Chess::PieceColour;
+    using Chess::Castling;
+    using Chess::toIndex;
+    using Chess::fromIndex;
+
+    inline constexpr uint8_t NO_EN_PASSANT_SQUARE = 64;
+
+    inline constexpr uint8_t RESULT_LOSS = 0;
+    inline constexpr uint8_t RESULT_DRAW = 1;
+    inline constexpr uint8_t RESULT_WIN = 2;
+
+    /**
+     * @brief Packs the current position of a game
+     * @param game Game object
+     * @param score Search score in centipawns from white's perspective
+     * @return Packed position with the result set to a draw
+     */
+    inline PackedPosition pack(Game& game, int16_t score) {
+        Board& board = game.getBoard();
+        PackedPosition position {};
+        position.occupancy = board.getPiecesBitboard();
+
+        Chess::Bitboard occupied = position.occupancy;
+        uint8_t index = 0;
+        while (occupied) {
+            uint8_t square = std::countr_zero(occupied);
+            auto [piece, colour] = board.getPieceAndColour(square);
+            uint8_t code = static_cast<uint8_t>((toIndex(colour) << 3) | toIndex(piece));
+            position.pieces[index >> 1] |= (index & 1) ? (code << 4) : code;
+
+            index++;
+            occupied &= occupied - 1;
+        }
+
+        position.score = score;
+        position.result = RESULT_DRAW;
+        position.flags = (game.getCurrentTurn() == Colour::BLACK) ? 1 : 0;
+        if (board.getCastlingRights(Colour::WHITE, Castling::KINGSIDE)) position.flags |= 1 << 1;
+        if (board.getCastlingRights(Colour::WHITE, Castling::QUEENSIDE)) position.flags |= 1 << 2;
+        if (board.getCastlingRights(Colour::BLACK, Castling::KINGSIDE)) position.flags |= 1 << 3;
+        if (board.getCastlingRights(Colour::BLACK, Castling::QUEENSIDE)) position.flags |= 1 << 4;
+
+        auto enPassantSquare = board.getEnPassantSquare();
+        position.enPassantSquare = enPassantSquare.has_value() ? *enPassantSquare : NO_EN_PASSANT_SQUARE;
+        position.halfMoveClock = game.getHalfMoveClock();
+        position.fullMoves = game.getFullMoves();
+
+        return position;
+    }
+
+    /**
+     * @brief Converts a packed position back into FEN notation
+     * @param position Packed position
+     * @return FEN string of the position
+     */
+    inline std::string toFen(const PackedPosition& position) {
+        constexpr char pieceSymbols[6] = {'p', 'n', 'b', 'r', 'q', 'k'};
+
+        char squares[64] = {};
+        Chess::Bitboard occupied = position.occupancy;
+        uint8_t index = 0;
+        while (occupied) {
+            uint8_t square = std::countr_zero(occupied);
+            uint8_t code = (position.pieces[index >> 1] >> ((index & 1) * 4)) & 0xF;
+            char symbol = pieceSymbols[code & 0x7];
+            squares[square] = (code >> 3) ? symbol : static_cast<char>(symbol - 'a' + 'A');
+
+            index++;
+            occupied &= occupied - 1;
+        }
+
+        std::string fen;
+        for (int rank = 7; rank >= 0; rank--) {
+            int emptyCount = 0;
+            for (int file = 0; file < 8; file++) {
+                char symbol = squares[rank * 8 + file];
+                if (!symbol) {
+                    emptyCount++;
+                    continue;
+                }
+                if (emptyCount) fen += static_cast<char>('0' + emptyCount);
+                emptyCount = 0;
+                fen += symbol;
+            }
+            if (emptyCount) fen += static_cast<char>('0' + emptyCount);
+            if (rank) fen += '/';
+        }
+
+        fen += (position.flags & 1) ? " b " : " w ";
+
+        std::string castling;
+        if (position.flags & (1 << 1)) castling += 'K';
+        if (position.flags & (1 << 2)) castling += 'Q';
+        if (position.flags & (1 << 3)) castling += 'k';
+        if (position.flags & (1 << 4)) castling += 'q';
+        fen += castling.empty() ? "-" : castling;
+
+        // FEN stores the square behind the pawn that can be captured en passant
+        if (position.enPassantSquare != NO_EN_PASSANT_SQUARE) {
+            uint8_t target = (position.flags & 1) ? position.enPassantSquare - 8 : position.enPassantSquare + 8;
+            fen += ' ';
+            fen += static_cast<char>('a' + Board::getFile(target));
+            fen += static_cast<char>('1' + Board::getRank(target));
+        } else {
+            fen += " -";
+        }
+
+        fen += ' ' + std::to_string(position.halfMoveClock) + ' ' + std::to_string(position.fullMoves);
+        return fen;
+    }
+}
+
+#endif // PACKED_POSITION_H
\ No newline at end of file
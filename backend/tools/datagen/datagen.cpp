@@ -0,0 +1,230 @@
+#include <cstdint>
+#include <cstdlib>
+#include <cstdio>
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <random>
+#include <algorithm>
+#include "game/game.h"
+#include "engine/engine.h"
+#include "move/move.h"
+#include "move/move_generator.h"
+#include "check/check.h"
+#include "common/packed_position.h"
+#include "chess_types.h"
+
+using Colour = Chess::PieceColour;
+
+namespace {
+    constexpr const char* START_FEN = "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1";
+
+    constexpr int DATAGEN_TIME_LIMIT = 1000000; // Effectively unlimited so that only the node limit stops the search
+    constexpr uint8_t DATAGEN_MAX_DEPTH = 64;
+    constexpr uint8_t DATAGEN_QUIESCENCE_DEPTH = 8;
+    constexpr std::size_t DATAGEN_TRANSPOSITION_TABLE_SIZE = 16; // Size in MB per thread
+
+    constexpr int RANDOM_OPENING_MOVES = 8;
+    constexpr int MAX_GAME_PLIES = 400;
+    constexpr int16_t MATE_SCORE_THRESHOLD = 25000;
+    constexpr int16_t ADJUDICATION_SCORE = 2000;
+    constexpr int ADJUDICATION_PLIES = 6;
+
+    constexpr std::size_t WRITE_BUFFER_RECORDS = 8192; // 256 KB per thread
+
+    struct Options {
+        std::string outputPath;
+        unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+        uint64_t gamesPerThread = 100;
+        uint64_t nodeLimit = 5000;
+        uint32_t seed = 1;
+    };
+
+    /**
+     * Output file shared by all workers, each of which appends whole buffers at a time
+     */
+    class OutputFile {
+    public:
+        explicit OutputFile(const std::string& path) : file(std::fopen(path.c_str(), "wb")) {}
+        ~OutputFile() { if (file) std::fclose(file); }
+
+        inline bool isOpen() const {
+            return file != nullptr;
+        }
+
+        void write(const std::vector<PackedPosition>& positions) {
+            std::lock_guard<std::mutex> lock(mutex);
+            std::fwrite(positions.data(), sizeof(PackedPosition), positions.size(), file);
+        }
+
+    private:
+        std::FILE* file;
+        std::mutex mutex;
+    };
+
+    std::atomic<uint64_t> totalGames{0};
+    std::atomic<uint64_t> totalPositions{0};
+    std::atomic<unsigned> finishedWorkers{0};
+
+    /**
+     * @brief Plays random legal moves from the starting position
+     * @return True if the game is still in progress after the opening, otherwise false
+     */
+    bool playRandomOpening(Game& game, std::mt19937& rng, std::vector<Move>& moves) {
+        game.setCustomGameState(START_FEN);
+
+        for (int i = 0; i < RANDOM_OPENING_MOVES; i++) {
+            moves.clear();
+            MoveGenerator::legalMoves(game.getBoard(), game.getCurrentTurn(), moves);
+            if (moves.empty()) return false;
+
+            game.makeMove(moves[rng() % moves.size()]);
+        }
+
+        GameStateEvaluation state = game.getCurrentGameStateEvaluation();
+        return state == GameStateEvaluation::IN_PROGRESS || state == GameStateEvaluation::CHECK;
+    }
+
+    /**
+     * @brief Plays self-play games and appends their positions to the output file
+     * @param index Index of the worker, used to give each worker a different random seed
+     */
+    void runWorker(unsigned index, const Options& options, OutputFile& output) {
+        Game game;
+        Engine engine(DATAGEN_TIME_LIMIT, DATAGEN_MAX_DEPTH, DATAGEN_QUIESCENCE_DEPTH, DATAGEN_TRANSPOSITION_TABLE_SIZE);
+        engine.setNodeLimit(options.nodeLimit);
+
+        std::mt19937 rng(options.seed + index);
+        std::vector<Move> moves;
+        std::vector<PackedPosition> gamePositions;
+        std::vector<PackedPosition> buffer;
+        buffer.reserve(WRITE_BUFFER_RECORDS);
+
+        for (uint64_t gameNumber = 0; gameNumber < options.gamesPerThread; gameNumber++) {
+            if (!playRandomOpening(game, rng, moves)) continue;
+
+            gamePositions.clear();
+            // Games reaching the ply limit are scored as draws
+            uint8_t result = PackedPositionFormat::RESULT_DRAW;
+            int winningPlies = 0;
+            int losingPlies = 0;
+            bool aborted = false;
+
+            for (int ply = 0; ply < MAX_GAME_PLIES; ply++) {
+                GameStateEvaluation state = game.getCurrentGameStateEvaluation();
+                if (state == GameStateEvaluation::CHECKMATE) {
+                    result = (game.getCurrentTurn() == Colour::WHITE) ? PackedPositionFormat::RESULT_LOSS : PackedPositionFormat::RESULT_WIN;
+                    break;
+                }
+                if (state != GameStateEvaluation::IN_PROGRESS && state != GameStateEvaluation::CHECK) break;
+
+                // Node limit reached before the first depth was completed
+                Move move = engine.getMove(game);
+                if (move == Move()) {
+                    aborted = true;
+                    break;
+                }
+
+                int16_t score = engine.getCurrentEvaluation();
+                bool quiet = move.getCapturedPiece() == Move::NO_CAPTURE && move.getPromotionPiece() == Move::NO_PROMOTION;
+
+                // Only quiet positions with non mate scores are useful for training a static evaluation
+                if (state != GameStateEvaluation::CHECK && quiet && std::abs(score) < MATE_SCORE_THRESHOLD) {
+                    gamePositions.push_back(PackedPositionFormat::pack(game, score));
+                }
+
+                // Adjudicate games which are clearly decided
+                winningPlies = (score >= ADJUDICATION_SCORE) ? winningPlies + 1 : 0;
+                losingPlies = (score <= -ADJUDICATION_SCORE) ? losingPlies + 1 : 0;
+                if (winningPlies >= ADJUDICATION_PLIES || losingPlies >= ADJUDICATION_PLIES) {
+                    result = (winningPlies) ? PackedPositionFormat::RESULT_WIN : PackedPositionFormat::RESULT_LOSS;
+                    break;
+                }
+
+                game.makeMove(move);
+            }
+
+            // Games whose search hit the node limit before completing depth 1 are discarded
+            if (aborted) continue;
+
+            for (PackedPosition& position : gamePositions) {
+                position.result = result;
+                buffer.push_back(position);
+
+                if (buffer.size() == WRITE_BUFFER_RECORDS) {
+                    output.write(buffer);
+                    buffer.clear();
+                }
+            }
+
+            totalPositions += gamePositions.size();
+            totalGames++;
+        }
+
+        if (!buffer.empty()) output.write(buffer);
+        finishedWorkers++;
+    }
+}
+
+/**
+ * Generates training data from self-play games
+ * Usage: Datagen <output file> [threads] [games per thread] [node limit] [seed]
+ */
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::cerr << "Usage: Datagen <output file> [threads] [games per thread] [node limit] [seed]\n";
+        return 1;
+    }
+
+    Options options;
+    options.outputPath = argv[1];
+    if (argc > 2) options.threads = std::max(1, std::atoi(argv[2]));
+    if (argc > 3) options.gamesPerThread = std::strtoull(argv[3], nullptr, 10);
+    if (argc > 4) options.nodeLimit = std::strtoull(argv[4], nullptr, 10);
+    if (argc > 5) options.seed = static_cast<uint32_t>(std::strtoul(argv[5], nullptr, 10));
+
+    OutputFile output(options.outputPath);
+    if (!output.isOpen()) {
+        std::cerr << "Failed to open " << options.outputPath << "\n";
+        return 1;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+
+    std::vector<std::thread> workers;
+    for (unsigned i = 0; i < options.threads; i++) {
+        workers.emplace_back(runWorker, i, std::cref(options), std::ref(output));
+    }
+
+    auto elapsedSeconds = [&start]() {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    };
+
+    double lastReport = 0.0;
+    while (finishedWorkers < options.threads) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+        if (elapsedSeconds() - lastReport >= 10.0) {
+            lastReport = elapsedSeconds();
+            std::cout << "games " << totalGames << " positions " << totalPositions
+                      << " positions/second " << std::fixed << std::setprecision(0) << totalPositions / lastReport << std::endl;
+        }
+    }
+
+    for (std::thread& worker : workers) worker.join();
+
+    double seconds = elapsedSeconds();
+    std::cout << "===========================\n"
+              << "Threads          : " << options.threads << "\n"
+              << "Games            : " << totalGames << "\n"
+              << "Positions        : " << totalPositions << "\n"
+              << "Time (s)         : " << std::fixed << std::setprecision(1) << seconds << "\n"
+              << "Positions/second : " << std::setprecision(0) << totalPositions / seconds << "\n";
+
+    return 0;
+}
\ No newline at end of file
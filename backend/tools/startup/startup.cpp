@@ -0,0 +1,74 @@
+#include <cstdint>
+#include <cstdlib>
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <algorithm>
+#ifndef _WIN32
+#include <spawn.h>
+#include <sys/wait.h>
+
+extern char** environ;
+#endif
+#include "move/precompute_moves.h"
+#include "engine/precompute.h"
+
+namespace {
+    constexpr int DEFAULT_RUNS = 200;
+    constexpr const char* CHILD_ARGUMENT = "--child";
+
+    /**
+     * @brief Runs this executable with --child and waits for it to exit
+     * @param executable Path of this executable
+     * @return True if the child was launched, otherwise false
+     * @note The child is spawned directly where posix_spawnp is available, otherwise it is started through the shell
+     */
+    bool runChild(const char* executable) {
+#ifdef _WIN32
+        std::string command = "\"";
+        command += executable;
+        command += "\" ";
+        command += CHILD_ARGUMENT;
+        return std::system(command.c_str()) != -1;
+#else
+        char* const childArgv[] = {const_cast<char*>(executable), const_cast<char*>(CHILD_ARGUMENT), nullptr};
+        pid_t pid;
+        if (posix_spawnp(&pid, executable, nullptr, nullptr, childArgv, environ) != 0) return false;
+
+        int status;
+        return waitpid(pid, &status, 0) == pid;
+#endif
+    }
+}
+
+/**
+ * Measures the time taken to start and exit a process linked against the backend, which includes the initialisation of all precomputed tables
+ * The tool launches itself with --child the given number of times and reports the mean wall time per process
+ * The time includes the cost of creating and exiting a process, so only the difference between two builds is meaningful
+ * Usage: Startup [runs]
+ */
+int main(int argc, char** argv) {
+    // Touch the tables so that the child cannot skip them
+    if (argc > 1 && std::string(argv[1]) == CHILD_ARGUMENT) {
+        uint64_t sliders = PrecomputeMoves::getRookMovesFromTable(0, 0ULL) ^ PrecomputeMoves::getBishopMovesFromTable(63, 0ULL);
+        return static_cast<int>((sliders ^ EnginePrecompute::passedPawnMaskTable[0][8]) & 1);
+    }
+
+    const int runs = (argc > 1) ? std::max(1, std::atoi(argv[1])) : DEFAULT_RUNS;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < runs; i++) {
+        if (!runChild(argv[0])) {
+            std::cerr << "Failed to launch " << argv[0] << "\n";
+            return 1;
+        }
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    double milliseconds = std::chrono::duration<double, std::milli>(end - start).count();
+    std::cout << "Runs                   : " << runs << "\n"
+              << "Startup time/run (ms)  : " << std::fixed << std::setprecision(3) << milliseconds / runs << "\n";
+
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,515 @@
+#include <cstdint>
+#include <cstdlib>
+#include <cstdio>
+#include <cmath>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <thread>
+#include <algorithm>
+#include "game/game.h"
+#include "board/board.h"
+#include "engine/evaluation.h"
+#include "engine/evaluation_trace.h"
+#include "engine/piece_tables.h"
+#include "engine/score.h"
+#include "common/packed_position.h"
+#include "chess_types.h"
+
+#ifndef EVALUATION_TRACE
+#error "The tuner must be compiled with EVALUATION_TRACE defined"
+#endif
+
+using Colour = Chess::PieceColour;
+
+enum class ParameterKind : uint8_t {
+    SCORE = 0, ///< Single packed weight
+    SCORE_ARRAY = 1, ///< Array of packed weights
+    TABLE = 2, ///< Piece square table with separate early game and end game tables, or a single table if tied
+    UNSIGNED_TABLES = 3 ///< Pair of early game and end game tables stored as uint8_t
+};
+
+/**
+ * Group of evaluation weights which are printed together as one constant
+ */
+struct ParameterGroup {
+    const char* name;
+    const char* endgameName; ///< Name of the end game table of a TABLE group, nullptr if the group is tied
+    ParameterKind kind;
+    std::vector<Score> initial;
+    bool tied; ///< Early game and end game weights share a single value
+    int16_t (*count)(const EvaluationTrace& trace, std::size_t index, uint8_t colour);
+};
+
+/**
+ * Lists the tunable weights of the classical evaluation alongside the evaluation trace counts they are multiplied by
+ * Material values are excluded since they are also used by move ordering, their positional part is absorbed by the piece square tables
+ */
+class Tuner {
+public:
+    static std::vector<ParameterGroup> parameterGroups() {
+        std::vector<ParameterGroup> groups;
+
+        auto table = [](const int16_t* midgame, const int16_t* endgame) {
+            std::vector<Score> scores;
+            for (int square = 0; square < 64; square++) scores.push_back(Score(midgame[square], endgame[square]));
+            return scores;
+        };
+
+        groups.push_back({"pawns", "pawnsEnd", ParameterKind::TABLE, table(PieceTables::pawns, PieceTables::pawnsEnd), false,
+                         [](const EvaluationTrace& t, std::size_t i, uint8_t c) { return t.pieceSquares[0][i][c]; }});
+        groups.push_back({"knights", nullptr, ParameterKind::TABLE, table(PieceTables::knights, PieceTables::knights), true,
+                         [](const EvaluationTrace& t, std::size_t i, uint8_t c) { return t.pieceSquares[1][i][c]; }});
+        groups.push_back({"bishops", nullptr, ParameterKind::TABLE, table(PieceTables::bishops, PieceTables::bishops), true,
+                         [](const EvaluationTrace& t, std::size_t i, uint8_t c) { return t.pieceSquares[2][i][c]; }});
+        groups.push_back({"rooks", nullptr, ParameterKind::TABLE, table(PieceTables::rooks, PieceTables::rooks), true,
+                         [](const EvaluationTrace& t, std::size_t i, uint8_t c) { return t.pieceSquares[3][i][c]; }});
+        groups.push_back({"queens", nullptr, ParameterKind::TABLE, table(PieceTables::queens, PieceTables::queens), true,
+                         [](const EvaluationTrace& t, std::size_t i, uint8_t c) { return t.pieceSquares[4][i][c]; }});
+        groups.push_back({"kings", "kingsEnd", ParameterKind::TABLE, table(PieceTables::kings, PieceTables::kingsEnd), false,
+                         [](const EvaluationTrace& t, std::size_t i, uint8_t c) { return t.pieceSquares[5][i][c]; }});
+
+        std::vector<Score> passedPawns(PieceTables::packedPassedPawnTable.begin(), PieceTables::packedPassedPawnTable.end());
+        groups.push_back({"passedPawnTables", nullptr, ParameterKind::UNSIGNED_TABLES, passedPawns, false,
+                         [](const EvaluationTrace& t, std::size_t i, uint8_t c) { return t.passedPawns[i][c]; }});
+
+        groups.push_back({"DOUBLED_PAWN_PENALTY", nullptr, ParameterKind::SCORE, {Evaluation::DOUBLED_PAWN_PENALTY}, false,
+                         [](const EvaluationTrace& t, std::size_t, uint8_t c) { return t.doubledPawns[c]; }});
+        groups.push_back({"ISOLATED_PAWN_PENALTY", nullptr, ParameterKind::SCORE, {Evaluation::ISOLATED_PAWN_PENALTY}, false,
+                         [](const EvaluationTrace& t, std::size_t, uint8_t c) { return t.isolatedPawns[c]; }});
+        groups.push_back({"BACKWARD_PAWN_PENALTY", nullptr, ParameterKind::SCORE, {Evaluation::BACKWARD_PAWN_PENALTY}, false,
+                         [](const EvaluationTrace& t, std::size_t, uint8_t c) { return t.backwardPawns[c]; }});
+        groups.push_back({"PAWN_CHAIN_BONUS", nullptr, ParameterKind::SCORE, {Evaluation::PAWN_CHAIN_BONUS}, false,
+                         [](const EvaluationTrace& t, std::size_t, uint8_t c) { return t.pawnChains[c]; }});
+        groups.push_back({"MAJOR_PAWN_SHIELD_BONUS", nullptr, ParameterKind::SCORE, {Evaluation::MAJOR_PAWN_SHIELD_BONUS}, false,
+                         [](const EvaluationTrace& t, std::size_t, uint8_t c) { return t.majorPawnShields[c]; }});
+        groups.push_back({"MINOR_PAWN_SHIELD_BONUS", nullptr, ParameterKind::SCORE, {Evaluation::MINOR_PAWN_SHIELD_BONUS}, false,
+                         [](const EvaluationTrace& t, std::size_t, uint8_t c) { return t.minorPawnShields[c]; }});
+        groups.push_back({"KING_TROPISM_KNIGHT_BONUS", nullptr, ParameterKind::SCORE, {Evaluation::KING_TROPISM_KNIGHT_BONUS}, false,
+                         [](const EvaluationTrace& t, std::size_t, uint8_t c) { return t.kingTropism[0][c]; }});
+        groups.push_back({"KING_TROPISM_BISHOP_BONUS", nullptr, ParameterKind::SCORE, {Evaluation::KING_TROPISM_BISHOP_BONUS}, false,
+                         [](const EvaluationTrace& t, std::size_t, uint8_t c) { return t.kingTropism[1][c]; }});
+        groups.push_back({"KING_TROPISM_ROOK_BONUS", nullptr, ParameterKind::SCORE, {Evaluation::KING_TROPISM_ROOK_BONUS}, false,
+                         [](const EvaluationTrace& t, std::size_t, uint8_t c) { return t.kingTropism[2][c]; }});
+        groups.push_back({"KING_TROPISM_QUEEN_BONUS", nullptr, ParameterKind::SCORE, {Evaluation::KING_TROPISM_QUEEN_BONUS}, false,
+                         [](const EvaluationTrace& t, std::size_t, uint8_t c) { return t.kingTropism[3][c]; }});
+        groups.push_back({"ROOK_OPEN_FILE_BONUS", nullptr, ParameterKind::SCORE, {Evaluation::ROOK_OPEN_FILE_BONUS}, false,
+                         [](const EvaluationTrace& t, std::size_t, uint8_t c) { return t.rookOpenFiles[c]; }});
+        groups.push_back({"ROOK_SEMI_OPEN_FILE_BONUS", nullptr, ParameterKind::SCORE, {Evaluation::ROOK_SEMI_OPEN_FILE_BONUS}, false,
+                         [](const EvaluationTrace& t, std::size_t, uint8_t c) { return t.rookSemiOpenFiles[c]; }});
+        groups.push_back({"QUEEN_OPEN_FILE_BONUS", nullptr, ParameterKind::SCORE, {Evaluation::QUEEN_OPEN_FILE_BONUS}, false,
+                         [](const EvaluationTrace& t, std::size_t, uint8_t c) { return t.queenOpenFiles[c]; }});
+        groups.push_back({"QUEEN_SEMI_OPEN_FILE_BONUS", nullptr, ParameterKind::SCORE, {Evaluation::QUEEN_SEMI_OPEN_FILE_BONUS}, false,
+                         [](const EvaluationTrace& t, std::size_t, uint8_t c) { return t.queenSemiOpenFiles[c]; }});
+        groups.push_back({"OPEN_FILE_NEAR_KING_PENALTY", nullptr, ParameterKind::SCORE, {Evaluation::OPEN_FILE_NEAR_KING_PENALTY}, false,
+                         [](const EvaluationTrace& t, std::size_t, uint8_t c) { return t.openFilesNearKing[c]; }});
+        groups.push_back({"SEMI_OPEN_FILE_NEAR_KING_PENALTY", nullptr, ParameterKind::SCORE, {Evaluation::SEMI_OPEN_FILE_NEAR_KING_PENALTY}, false,
+                         [](const EvaluationTrace& t, std::size_t, uint8_t c) { return t.semiOpenFilesNearKing[c]; }});
+        groups.push_back({"KING_ZONE_ATTACK_PENALTIES", nullptr, ParameterKind::SCORE_ARRAY,
+                         std::vector<Score>(std::begin(Evaluation::KING_ZONE_ATTACK_PENALTIES), std::end(Evaluation::KING_ZONE_ATTACK_PENALTIES)), false,
+                         [](const EvaluationTrace& t, std::size_t i, uint8_t c) { return t.kingZoneAttacks[i][c]; }});
+        groups.push_back({"BISHOP_MOBILITY_BONUSES", nullptr, ParameterKind::SCORE_ARRAY,
+                         std::vector<Score>(std::begin(Evaluation::BISHOP_MOBILITY_BONUSES), std::end(Evaluation::BISHOP_MOBILITY_BONUSES)), false,
+                         [](const EvaluationTrace& t, std::size_t i, uint8_t c) { return t.bishopMobility[i][c]; }});
+        groups.push_back({"KNIGHT_MOBILITY_BONUSES", nullptr, ParameterKind::SCORE_ARRAY,
+                         std::vector<Score>(std::begin(Evaluation::KNIGHT_MOBILITY_BONUSES), std::end(Evaluation::KNIGHT_MOBILITY_BONUSES)), false,
+                         [](const EvaluationTrace& t, std::size_t i, uint8_t c) { return t.knightMobility[i][c]; }});
+        groups.push_back({"CONNECTED_ROOK_BONUS", nullptr, ParameterKind::SCORE, {Evaluation::CONNECTED_ROOK_BONUS}, false,
+                         [](const EvaluationTrace& t, std::size_t, uint8_t c) { return t.connectedRooks[c]; }});
+        groups.push_back({"PAWN_STORM_BONUS", nullptr, ParameterKind::SCORE, {Evaluation::PAWN_STORM_BONUS}, false,
+                         [](const EvaluationTrace& t, std::size_t, uint8_t c) { return t.pawnStorms[c]; }});
+        groups.push_back({"PAWN_STORM_PROXIMITY_BONUS", nullptr, ParameterKind::SCORE, {Evaluation::PAWN_STORM_PROXIMITY_BONUS}, false,
+                         [](const EvaluationTrace& t, std::size_t, uint8_t c) { return t.pawnStormProximity[c]; }});
+
+        return groups;
+    }
+
+    static constexpr int MAX_PHASE = Evaluation::MAX_PHASE;
+};
+
+namespace {
+    constexpr double LN_10 = 2.302585092994046;
+
+    constexpr double ADAM_BETA1 = 0.9;
+    constexpr double ADAM_BETA2 = 0.999;
+    constexpr double ADAM_EPSILON = 1e-8;
+
+    constexpr int REPORT_INTERVAL = 50; // Epochs between progress reports
+
+    struct Options {
+        std::string dataPath;
+        unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+        int epochs = 1000;
+        double learningRate = 1.0;
+        std::string outputPath = "tuned_weights.txt";
+    };
+
+    struct Weight {
+        double midgame;
+        double endgame;
+    };
+
+    /**
+     * Non zero trace count of a single weight, as the white count minus the black count
+     */
+    struct Coefficient {
+        uint16_t index;
+        int16_t count;
+    };
+
+    /**
+     * Compact linearised form of a training position
+     */
+    struct TunerEntry {
+        uint32_t firstCoefficient; ///< Index of the first coefficient of the position in the shared coefficient array
+        uint16_t coefficientCount;
+        uint8_t phase;
+        float result; ///< Game result from white's perspective (0 = loss, 0.5 = draw, 1 = win)
+        int16_t material; ///< Material difference from white's perspective, which is not tuned
+    };
+
+    struct Dataset {
+        std::vector<TunerEntry> entries;
+        std::vector<Coefficient> coefficients;
+    };
+
+    /**
+     * Splits [0, size) into one contiguous range per thread and runs the task on each range in parallel
+     */
+    template <typename Task>
+    void parallelFor(std::size_t size, unsigned threads, Task task) {
+        std::vector<std::thread> workers;
+        std::size_t chunk = (size + threads - 1) / threads;
+        for (unsigned i = 0; i < threads; i++) {
+            std::size_t begin = std::min(size, i * chunk);
+            std::size_t end = std::min(size, begin + chunk);
+            workers.emplace_back(task, i, begin, end);
+        }
+        for (std::thread& worker : workers) worker.join();
+    }
+
+    /**
+     * @brief Linearised evaluation of a position
+     * @return Evaluation in centipawns from white's perspective
+     */
+    inline double linearEvaluation(const TunerEntry& entry, const Dataset& data, const std::vector<Weight>& weights) {
+        double midgame = 0.0;
+        double endgame = 0.0;
+        const Coefficient* coefficient = &data.coefficients[entry.firstCoefficient];
+        for (uint16_t i = 0; i < entry.coefficientCount; i++, coefficient++) {
+            midgame += coefficient->count * weights[coefficient->index].midgame;
+            endgame += coefficient->count * weights[coefficient->index].endgame;
+        }
+
+        return entry.material + (midgame * entry.phase + endgame * (Tuner::MAX_PHASE - entry.phase)) / Tuner::MAX_PHASE;
+    }
+
+    inline double sigmoid(double k, double eval) {
+        return 1.0 / (1.0 + std::pow(10.0, -k * eval / 400.0));
+    }
+
+    /**
+     * @brief Reads the packed positions written by Datagen and converts them into their linearised form in parallel
+     * @param maxError Set to the largest difference found between the linearised and the real evaluation
+     */
+    Dataset loadDataset(const Options& options, const std::vector<ParameterGroup>& groups, double& maxError) {
+        std::vector<PackedPosition> positions;
+        std::ifstream file(options.dataPath, std::ios::binary | std::ios::ate);
+        if (!file) return {};
+
+        std::size_t count = static_cast<std::size_t>(file.tellg()) / sizeof(PackedPosition);
+        positions.resize(count);
+        file.seekg(0);
+        file.read(reinterpret_cast<char*>(positions.data()), count * sizeof(PackedPosition));
+
+        std::vector<Weight> initialWeights;
+        for (const ParameterGroup& group : groups) {
+            for (Score score : group.initial) initialWeights.push_back({double(score.midgame()), double(score.endgame())});
+        }
+
+        std::vector<Dataset> partial(options.threads);
+        std::vector<double> errors(options.threads, 0.0);
+
+        parallelFor(count, options.threads, [&](unsigned thread, std::size_t begin, std::size_t end) {
+            Dataset& data = partial[thread];
+            Game game;
+
+            for (std::size_t i = begin; i < end; i++) {
+                const PackedPosition& position = positions[i];
+                game.setCustomGameState(PackedPositionFormat::toFen(position).c_str());
+                Board& board = game.getBoard();
+
+                Evaluation::clearTrace();
+                int16_t eval = Evaluation::staticEvaluation(game);
+                const EvaluationTrace& trace = Evaluation::getTrace();
+
+                TunerEntry entry {};
+                entry.firstCoefficient = static_cast<uint32_t>(data.coefficients.size());
+                entry.phase = static_cast<uint8_t>(std::min<int16_t>(board.getPhase(), Tuner::MAX_PHASE));
+                entry.result = position.result / 2.0f;
+                entry.material = board.getMaterial(Colour::WHITE) - board.getMaterial(Colour::BLACK);
+
+                uint16_t index = 0;
+                for (const ParameterGroup& group : groups) {
+                    for (std::size_t j = 0; j < group.initial.size(); j++, index++) {
+                        int16_t coefficient = group.count(trace, j, 0) - group.count(trace, j, 1);
+                        if (coefficient) data.coefficients.push_back({index, coefficient});
+                    }
+                }
+                entry.coefficientCount = static_cast<uint16_t>(data.coefficients.size() - entry.firstCoefficient);
+                data.entries.push_back(entry);
+
+                // The evaluation is from the perspective of the player to move
+                double whiteEval = (game.getCurrentTurn() == Colour::WHITE) ? eval : -eval;
+                errors[thread] = std::max(errors[thread], std::abs(linearEvaluation(entry, data, initialWeights) - whiteEval));
+            }
+        });
+
+        Dataset data;
+        data.entries.reserve(count);
+        for (const Dataset& part : partial) {
+            uint32_t offset = static_cast<uint32_t>(data.coefficients.size());
+            for (TunerEntry entry : part.entries) {
+                entry.firstCoefficient += offset;
+                data.entries.push_back(entry);
+            }
+            data.coefficients.insert(data.coefficients.end(), part.coefficients.begin(), part.coefficients.end());
+        }
+
+        maxError = *std::max_element(errors.begin(), errors.end());
+        return data;
+    }
+
+    /**
+     * @brief Mean squared error between the game results and the predicted win probabilities
+     */
+    double computeLoss(const Dataset& data, const std::vector<Weight>& weights, double k, unsigned threads) {
+        std::vector<double> losses(threads, 0.0);
+        parallelFor(data.entries.size(), threads, [&](unsigned thread, std::size_t begin, std::size_t end) {
+            double loss = 0.0;
+            for (std::size_t i = begin; i < end; i++) {
+                double error = data.entries[i].result - sigmoid(k, linearEvaluation(data.entries[i], data, weights));
+                loss += error * error;
+            }
+            losses[thread] = loss;
+        });
+
+        double total = 0.0;
+        for (double loss : losses) total += loss;
+        return total / data.entries.size();
+    }
+
+    /**
+     * @brief Finds the sigmoid scaling constant which best maps the initial evaluation onto the game results
+     * @note Golden section search, the loss is unimodal in k
+     */
+    double computeOptimalK(const Dataset& data, const std::vector<Weight>& weights, unsigned threads) {
+        const double ratio = (std::sqrt(5.0) - 1.0) / 2.0;
+        double low = 0.0;
+        double high = 4.0;
+
+        while (high - low > 1e-4) {
+            double a = high - ratio * (high - low);
+            double b = low + ratio * (high - low);
+            if (computeLoss(data, weights, a, threads) < computeLoss(data, weights, b, threads)) {
+                high = b;
+            } else {
+                low = a;
+            }
+        }
+
+        return (low + high) / 2.0;
+    }
+
+    /**
+     * @brief Computes the gradient of the loss with respect to every weight
+     */
+    void computeGradient(const Dataset& data, const std::vector<Weight>& weights, double k, unsigned threads, std::vector<Weight>& gradient) {
+        std::vector<std::vector<Weight>> partial(threads, std::vector<Weight>(weights.size(), Weight{0.0, 0.0}));
+
+        parallelFor(data.entries.size(), threads, [&](unsigned thread, std::size_t begin, std::size_t end) {
+            std::vector<Weight>& local = partial[thread];
+            for (std::size_t i = begin; i < end; i++) {
+                const TunerEntry& entry = data.entries[i];
+                double probability = sigmoid(k, linearEvaluation(entry, data, weights));
+
+                // Derivative of the squared error with respect to the evaluation
+                double derivative = (probability - entry.result) * probability * (1.0 - probability);
+                double midgameScale = derivative * entry.phase / Tuner::MAX_PHASE;
+                double endgameScale = derivative * (Tuner::MAX_PHASE - entry.phase) / Tuner::MAX_PHASE;
+
+                const Coefficient* coefficient = &data.coefficients[entry.firstCoefficient];
+                for (uint16_t j = 0; j < entry.coefficientCount; j++, coefficient++) {
+                    local[coefficient->index].midgame += midgameScale * coefficient->count;
+                    local[coefficient->index].endgame += endgameScale * coefficient->count;
+                }
+            }
+        });
+
+        // Constant factors of the derivative are applied once here rather than per position
+        const double scale = 2.0 * k * LN_10 / 400.0 / data.entries.size();
+        for (std::size_t i = 0; i < weights.size(); i++) {
+            gradient[i] = {0.0, 0.0};
+            for (const std::vector<Weight>& local : partial) {
+                gradient[i].midgame += local[i].midgame * scale;
+                gradient[i].endgame += local[i].endgame * scale;
+            }
+        }
+    }
+
+    void printScore(std::ostream& out, const Weight& weight) {
+        out << "Score(" << std::lround(weight.midgame) << ", " << std::lround(weight.endgame) << ")";
+    }
+
+    void printTable(std::ostream& out, const char* type, const char* name, const Weight* weights, bool endgame, bool clampUnsigned) {
+        if (name) out << "inline constexpr " << type << " " << name << "[64] = {\n";
+        for (int rank = 0; rank < 8; rank++) {
+            out << "\t";
+            for (int file = 0; file < 8; file++) {
+                const Weight& weight = weights[rank * 8 + file];
+                long value = std::lround(endgame ? weight.endgame : weight.midgame);
+                if (clampUnsigned) value = std::clamp(value, 0L, 255L);
+                out << std::setw(4) << value << (rank * 8 + file < 63 ? "," : "");
+            }
+            out << "\n";
+        }
+        if (name) out << "};\n\n";
+    }
+
+    /**
+     * @brief Prints the weights as C++ constants in the layout of piece_tables.h and evaluation.h
+     */
+    void printWeights(std::ostream& out, const std::vector<ParameterGroup>& groups, const std::vector<Weight>& weights) {
+        std::size_t index = 0;
+        for (const ParameterGroup& group : groups) {
+            const Weight* groupWeights = &weights[index];
+            index += group.initial.size();
+
+            switch (group.kind) {
+                case ParameterKind::SCORE:
+                    out << "static constexpr Score " << group.name << " = ";
+                    printScore(out, groupWeights[0]);
+                    out << ";\n";
+                    break;
+                case ParameterKind::SCORE_ARRAY:
+                    out << "static constexpr Score " << group.name << "[" << group.initial.size() << "] = {\n    ";
+                    for (std::size_t i = 0; i < group.initial.size(); i++) {
+                        printScore(out, groupWeights[i]);
+                        if (i + 1 < group.initial.size()) out << ((i % 7 == 6) ? ",\n    " : ", ");
+                    }
+                    out << "\n};\n";
+                    break;
+                case ParameterKind::TABLE:
+                    printTable(out, "int16_t", group.name, groupWeights, false, false);
+                    if (!group.tied) printTable(out, "int16_t", group.endgameName, groupWeights, true, false);
+                    break;
+                case ParameterKind::UNSIGNED_TABLES:
+                    out << "inline constexpr std::array<std::array<uint8_t, 64>, 2> " << group.name << " = {{{\n";
+                    printTable(out, "uint8_t", nullptr, groupWeights, false, true);
+                    out << "},\n{\n";
+                    printTable(out, "uint8_t", nullptr, groupWeights, true, true);
+                    out << "}}};\n\n";
+                    break;
+            }
+        }
+    }
+}
+
+/**
+ * Tunes the weights of the classical evaluation on positions labelled with game results (Texel tuning)
+ * The data file is the output of Datagen and the tuned weights are written to the output file as C++ constants
+ * Usage: Tuner <data file> [threads] [epochs] [learning rate] [output file]
+ */
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::cerr << "Usage: Tuner <data file> [threads] [epochs] [learning rate] [output file]\n";
+        return 1;
+    }
+
+    Options options;
+    options.dataPath = argv[1];
+    if (argc > 2) options.threads = std::max(1, std::atoi(argv[2]));
+    if (argc > 3) options.epochs = std::atoi(argv[3]);
+    if (argc > 4) options.learningRate = std::atof(argv[4]);
+    if (argc > 5) options.outputPath = argv[5];
+
+    const std::vector<ParameterGroup> groups = Tuner::parameterGroups();
+    std::vector<Weight> weights;
+    std::vector<bool> tied;
+    for (const ParameterGroup& group : groups) {
+        for (Score score : group.initial) {
+            weights.push_back({double(score.midgame()), double(score.endgame())});
+            tied.push_back(group.tied);
+        }
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    auto elapsedSeconds = [&start]() {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    };
+
+    double maxError = 0.0;
+    Dataset data = loadDataset(options, groups, maxError);
+    if (data.entries.empty()) {
+        std::cerr << "No positions loaded from " << options.dataPath << "\n";
+        return 1;
+    }
+
+    std::cout << "Positions    : " << data.entries.size() << "\n"
+              << "Parameters   : " << weights.size() << " (" << 2 * weights.size() << " weights)\n"
+              << "Memory (MB)  : " << std::fixed << std::setprecision(1)
+              << (data.entries.size() * sizeof(TunerEntry) + data.coefficients.size() * sizeof(Coefficient)) / (1024.0 * 1024.0) << "\n"
+              << "Load time (s): " << elapsedSeconds() << "\n"
+              << "Max linearisation error (cp): " << maxError << "\n";
+
+    const double k = computeOptimalK(data, weights, options.threads);
+    std::cout << "K            : " << std::setprecision(4) << k << "\n"
+              << "Initial loss : " << std::setprecision(6) << computeLoss(data, weights, k, options.threads) << std::endl;
+
+    std::vector<Weight> gradient(weights.size());
+    std::vector<Weight> momentum(weights.size(), Weight{0.0, 0.0});
+    std::vector<Weight> velocity(weights.size(), Weight{0.0, 0.0});
+
+    start = std::chrono::steady_clock::now();
+    for (int epoch = 1; epoch <= options.epochs; epoch++) {
+        computeGradient(data, weights, k, options.threads, gradient);
+
+        const double correction1 = 1.0 - std::pow(ADAM_BETA1, epoch);
+        const double correction2 = 1.0 - std::pow(ADAM_BETA2, epoch);
+        for (std::size_t i = 0; i < weights.size(); i++) {
+            // Tied weights are a single value used in both phases
+            if (tied[i]) {
+                gradient[i].midgame += gradient[i].endgame;
+                gradient[i].endgame = gradient[i].midgame;
+            }
+
+            momentum[i].midgame = ADAM_BETA1 * momentum[i].midgame + (1.0 - ADAM_BETA1) * gradient[i].midgame;
+            momentum[i].endgame = ADAM_BETA1 * momentum[i].endgame + (1.0 - ADAM_BETA1) * gradient[i].endgame;
+            velocity[i].midgame = ADAM_BETA2 * velocity[i].midgame + (1.0 - ADAM_BETA2) * gradient[i].midgame * gradient[i].midgame;
+            velocity[i].endgame = ADAM_BETA2 * velocity[i].endgame + (1.0 - ADAM_BETA2) * gradient[i].endgame * gradient[i].endgame;
+
+            weights[i].midgame -= options.learningRate * (momentum[i].midgame / correction1) /
+                                  (std::sqrt(velocity[i].midgame / correction2) + ADAM_EPSILON);
+            weights[i].endgame -= options.learningRate * (momentum[i].endgame / correction1) /
+                                  (std::sqrt(velocity[i].endgame / correction2) + ADAM_EPSILON);
+        }
+
+        if (epoch % REPORT_INTERVAL == 0 || epoch == options.epochs) {
+            std::cout << "epoch " << epoch << " loss " << std::setprecision(6) << computeLoss(data, weights, k, options.threads)
+                      << " time " << std::setprecision(1) << elapsedSeconds() << " s" << std::endl;
+        }
+    }
+
+    std::ofstream output(options.outputPath);
+    if (!output) {
+        std::cerr << "Failed to open " << options.outputPath << "\n";
+        return 1;
+    }
+    printWeights(output, groups, weights);
+    std::cout << "Tuned weights written to " << options.outputPath << "\n";
+
+    return 0;
+}
\ No newline at end of file
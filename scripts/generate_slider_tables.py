@@ -0,0 +1,160 @@
+import textwrap
+import os
+
+print(os.getcwd())
+
+SQUARES_NUM = 64
+VALUES_PER_LINE = 8
+
+def get_rank(square):
+    return square // 8
+
+def get_file(square):
+    return square % 8
+
+# Masks of potential blockers not including edge squares, matching generateRookMask and generateBishopMask
+def rook_mask(square):
+    left_file_mask = 0x0001010101010100 # A2-A7
+    bottom_rank_mask = 0x7E # B1-G1
+
+    mask = (left_file_mask << get_file(square)) | (bottom_rank_mask << (8 * get_rank(square)))
+    return mask & ~(1 << square) & 0xFFFFFFFFFFFFFFFF
+
+def bishop_mask(square):
+    directions = [7, 9, -9, -7] # ↖, ↗, ↙, ↘
+    rank_checks = [7, 7, 0, 0]
+    file_checks = [0, 7, 0, 7]
+
+    mask = 0
+    for i in range(4):
+        if get_rank(square) != rank_checks[i] and get_file(square) != file_checks[i]:
+            new_square = square + directions[i]
+            while get_rank(new_square) != rank_checks[i] and get_file(new_square) != file_checks[i]:
+                mask |= 1 << new_square
+                new_square += directions[i]
+
+    return mask
+
+# Moves including the final square in each ray, matching the ray walk previously done at startup
+def rook_moves(square, blockers):
+    directions = [-1, 8, 1, -8] # ←, ↑, →, ↓
+    boundary_checks = [0, 7, 7, 0] # file, rank, file, rank
+    functions = [get_file, get_rank]
+
+    moves = 0
+    for i in range(4):
+        check = functions[i & 1]
+        if check(square) != boundary_checks[i]:
+            new_square = square + directions[i]
+            while check(new_square) != boundary_checks[i] and not (blockers >> new_square) & 1:
+                moves |= 1 << new_square
+                new_square += directions[i]
+            moves |= 1 << new_square
+
+    return moves
+
+def bishop_moves(square, blockers):
+    directions = [7, 9, -9, -7] # ↖, ↗, ↙, ↘
+    rank_checks = [7, 7, 0, 0]
+    file_checks = [0, 7, 0, 7]
+
+    moves = 0
+    for i in range(4):
+        if get_file(square) != file_checks[i] and get_rank(square) != rank_checks[i]:
+            new_square = square + directions[i]
+            while (get_file(new_square) != file_checks[i] and
+                   get_rank(new_square) != rank_checks[i] and
+                   not (blockers >> new_square) & 1):
+                moves |= 1 << new_square
+                new_square += directions[i]
+            moves |= 1 << new_square
+
+    return moves
+
+# Scatters the bits of a pext index onto the set bits of the mask in ascending order
+def pext_index_to_blockers(pext_index, mask):
+    blockers = 0
+    bit_index = 0
+    while mask:
+        mask_bit = mask & -mask
+        if (pext_index >> bit_index) & 1:
+            blockers |= mask_bit
+        bit_index += 1
+        mask &= mask - 1
+
+    return blockers
+
+# Move table of all squares, indexed as [offset of square + pext index of blockers]
+def generate_table(mask_function, moves_function):
+    table = []
+    for square in range(SQUARES_NUM):
+        mask = mask_function(square)
+        for pext_index in range(1 << bin(mask).count("1")):
+            table.append(moves_function(square, pext_index_to_blockers(pext_index, mask)))
+
+    return table
+
+rook_table = generate_table(rook_mask, rook_moves)
+bishop_table = generate_table(bishop_mask, bishop_moves)
+
+# Converts the table to a C++ style string
+def format_table(table, var_name):
+    lines = [f"const uint64_t SliderTables::{var_name}[{len(table)}] = {{"]
+
+    for i in range(0, len(table), VALUES_PER_LINE):
+        row = ", ".join(f"0x{value:016X}ULL" for value in table[i:i + VALUES_PER_LINE])
+        lines.append(f"    {row},")
+
+    lines.append("};")
+    return "\n".join(lines)
+
+def create_header_file(filename):
+    header_code = textwrap.dedent(f"""\
+    #ifndef SLIDER_TABLES_H
+    #define SLIDER_TABLES_H
+
+    #include <cstdint>
+    #include <cstddef>
+
+    // Generated by scripts/generate_slider_tables.py
+    namespace SliderTables {{
+        inline constexpr std::size_t ROOK_MOVE_TABLE_SIZE = {len(rook_table)};
+        inline constexpr std::size_t BISHOP_MOVE_TABLE_SIZE = {len(bishop_table)};
+
+        /// Rook moves for every square and blocker permutation, indexed as [rook offset of square + pext index of blockers]
+        extern const uint64_t rookMoveTable[ROOK_MOVE_TABLE_SIZE];
+
+        /// Bishop moves for every square and blocker permutation, indexed as [bishop offset of square + pext index of blockers]
+        extern const uint64_t bishopMoveTable[BISHOP_MOVE_TABLE_SIZE];
+    }}
+
+    #endif // SLIDER_TABLES_H
+    """)
+
+    with open(filename, "w") as file:
+        file.write(header_code)
+
+    print(f"Slider table declarations have been written to {filename}")
+
+def create_cpp_file(filename):
+    cpp_code = textwrap.dedent("""\
+    #include <cstdint>
+    #include "move/slider_tables.h"
+
+    // Generated by scripts/generate_slider_tables.py
+
+    """)
+
+    cpp_code += format_table(rook_table, "rookMoveTable") + "\n\n"
+    cpp_code += format_table(bishop_table, "bishopMoveTable") + "\n"
+
+    with open(filename, "w") as file:
+        file.write(cpp_code)
+
+    print(f"Slider tables have been written to {filename}")
+
+header_file_path = "backend/include/move/slider_tables.h"
+create_header_file(header_file_path)
+
+cpp_relative_path = "backend/src/move/slider_tables.cpp"
+create_cpp_file(cpp_relative_path)
\ No newline at end of file